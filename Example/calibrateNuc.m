@@ -0,0 +1,26 @@
+% Connect to NITCam
+cam = clib.NITCam.NITCam();
+
+% Configer trigger mode
+cam.activateTriggerMode(true);
+
+% Exposure times to calibrate, one NUC file each
+gatedMode = true;
+triggerDelayInput = 0.45; % in µs
+exposureTimes = [0.1 0.2 0.3 0.4 0.5]; % in µs
+framesPerPoint = 200;
+rejectSigma = 4; % samples further from the pixel mean are ignored, 0 keeps all
+
+% Low point: uniform dark scene
+input('Cover the lens with the dark flat field and press enter');
+cam.captureNucLowPoints(gatedMode, triggerDelayInput, exposureTimes, numel(exposureTimes), framesPerPoint, rejectSigma);
+
+% High point: uniform bright scene
+input('Show the bright flat field and press enter');
+cam.captureNucHighPoints(gatedMode, triggerDelayInput, exposureTimes, numel(exposureTimes), framesPerPoint, rejectSigma);
+
+% Write <nucDir>\NUCFactory_Gated_<exposure>us.yml and correct the frames with them
+% the files are NITCam tables, load them later with loadNucTables (not setNucDirectory)
+nucDir = 'D:\NITsnap\Calibration';
+numFiles = cam.writeNucCalibration(nucDir);
+cam.useSoftwareNuc(true);
@@ -0,0 +1,33 @@
+% Connect to NITCam
+cam = clib.NITCam.NITCam();
+
+% Set and activate NUC File
+nucFile_200ns = 'D:\NITsnap\NUC\NUCFactory_0.2us.yml';
+cam.setNucFile(nucFile_200ns);
+cam.activateNuc(true);
+
+% Configer trigger mode
+cam.activateTriggerMode(true);
+
+% Sweep the trigger delay, one averaged slice per delay
+gatedMode = true;
+bitMode = 0; % 0=14-bit;
+triggerDelays = 0.30:0.01:0.80; % in µs
+numSteps = numel(triggerDelays);
+exposureTimes = repmat(0.1, 1, numSteps); % in µs
+framesPerStep = int32(repmat(4, 1, numSteps));
+if cam.captureDelaySweep(gatedMode, bitMode, triggerDelays, exposureTimes, framesPerStep, numSteps)
+    rows = double(cam.capturedRows());
+    cols = double(cam.capturedColumns());
+    data = cam.frameData16(rows * cols * numSteps);
+    % C++ buffer is delay x rows x columns (row major) -> rows x columns x delay
+    tofStack = permute(reshape(data, cols, rows, numSteps), [2 1 3]);
+end
+
+% Reconstruct range from the sweep, 2 = parabolic fit between delay steps
+method = 2;
+minIntensity = 200;
+if cam.reconstructRange(method, minIntensity)
+    rangeImage = reshape(cam.rangeMap(rows * cols), cols, rows)'; % in m
+    intensityImage = reshape(cam.intensityMap(rows * cols), cols, rows)';
+end
@@ -0,0 +1,34 @@
+% Connect to NITCam
+cam = clib.NITCam.NITCam();
+
+% Configer trigger mode
+cam.activateTriggerMode(true);
+cam.setMemoryFormat(true, false); % column major, no permute of the captured data
+
+% Scan positions: the camera integrates the next stack while MATLAB processes the last one
+gatedMode = true;
+bitMode = 0; % 0=14-bit -> uint16, 1/2=8-bit -> uint8
+triggerDelayInput = 0.45; % in µs
+exposureTime = 0.1; % in µs
+numTofImages = 100;
+numPositions = 5;
+meanImages = cell(1, numPositions);
+
+handle = cam.startCapture(gatedMode, bitMode, triggerDelayInput, exposureTime, numTofImages);
+for position = 1:numPositions
+    if ~cam.fetch(handle)
+        error("Capture at position %d failed", position);
+    end
+    rows = double(cam.capturedRows());
+    cols = double(cam.capturedColumns());
+    frames = double(cam.capturedFrames());
+    data = cam.frameData16(rows * cols * frames);
+
+    % move the stage / fire the laser here, then start the next stack before processing this one
+    if position < numPositions
+        handle = cam.startCapture(gatedMode, bitMode, triggerDelayInput, exposureTime, numTofImages);
+    end
+
+    tofImages = reshape(data, rows, cols, frames);
+    meanImages{position} = mean(single(tofImages), 3);
+end
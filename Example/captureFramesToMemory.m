@@ -0,0 +1,41 @@
+% Connect to NITCam
+cam = clib.NITCam.NITCam();
+
+% Configer trigger mode
+cam.activateTriggerMode(true);
+
+% Store the frames column major (MATLAB layout) while they arrive, no permute of the captured data
+columnMajor = true;
+cam.setMemoryFormat(columnMajor, false);
+
+% Capture number of images into memory, no files are written
+gatedMode = true;
+bitMode = 0; % 0=14-bit -> uint16, 1/2=8-bit -> uint8
+triggerDelayInput = 0.45; % in µs
+exposureTime = 0.1; % in µs
+numTofImages = 10;
+if cam.captureFramesToMemory(gatedMode, bitMode, triggerDelayInput, exposureTime, numTofImages)
+    rows = double(cam.capturedRows());
+    cols = double(cam.capturedColumns());
+    frames = double(cam.capturedFrames());
+    numel = rows * cols * frames;
+    if bitMode == 0
+        data = cam.frameData16(numel);
+    else
+        data = cam.frameData8(numel);
+    end
+    if columnMajor
+        tofImages = reshape(data, rows, cols, frames);
+    else
+        % C++ buffer is frames x rows x columns (row major) -> rows x columns x frames
+        tofImages = permute(reshape(data, cols, rows, frames), [2 1 3]);
+    end
+
+    % One metadata row per frame: dropped frames leave gaps in the Ids
+    numFrames = double(cam.metadataFrames());
+    ids = cam.metadataIds(numFrames);
+    temperatures = cam.metadataTemperatures(numFrames);
+    if any(diff(double(ids)) ~= 1)
+        warning("Frames were dropped during the capture");
+    end
+end
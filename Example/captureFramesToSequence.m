@@ -0,0 +1,21 @@
+% Connect to NITCam
+cam = clib.NITCam.NITCam();
+
+% Configer trigger mode
+cam.activateTriggerMode(true);
+
+% Record number of images into one sequence file <saveDir>/<fileName>.seq
+saveDir = 'D:\NITsnap';
+fileName = 'sequence';
+fileType = 'seq';
+gatedMode = true;
+bitMode = 0; % 0=14-bit -> uint16, 1/2=8-bit -> uint8
+triggerDelayInput = 0.45; % in µs
+exposureTime = 0.1; % in µs
+numTofImages = 1000;
+if cam.captureFrames(saveDir, fileName, fileType, gatedMode, bitMode, triggerDelayInput, exposureTime, numTofImages)
+    [frames, index, info] = readNITSequence(fullfile(saveDir, [fileName '.seq']));
+    % frames are mapped, only the indexed images are read from disk
+    firstImage = frames.Data.pixels(:, :, 1).';
+    lastImage = frames.Data.pixels(:, :, end).';
+end
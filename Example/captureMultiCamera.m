@@ -0,0 +1,45 @@
+% Connect to all discovered cameras (or give their serial numbers: "SN1,SN2")
+cams = clib.NITCam.NITCamArray();
+numCams = double(cams.open(""));
+if numCams == 0
+    error("No camera could be opened");
+end
+
+% Same settings on every camera, applied in parallel
+gatedMode = true;
+bitMode = 0; % 0=14-bit -> uint16
+triggerDelayInput = 0.45; % in µs
+exposureTime = 0.1; % in µs
+numFrames = 100;
+if ~cams.configure(gatedMode, triggerDelayInput, exposureTime)
+    error("Configuration failed");
+end
+
+% Arm in trigger mode, then start the common trigger
+if ~cams.arm(256, bitMode)
+    error("Arming failed");
+end
+
+rows = 512;
+cols = 640;
+images = zeros(rows, cols, numCams, numFrames, "uint16");
+ids = zeros(1, numFrames);
+frame = 0;
+while frame < numFrames
+    if ~cams.nextAlignedFrames()
+        pause(0.005);
+        continue;
+    end
+    frame = frame + 1;
+    ids(frame) = double(cams.alignedFrameId());
+    for cam = 1:numCams
+        data = cams.alignedFrameData16(cam - 1, rows * cols);
+        images(:, :, cam, frame) = reshape(data, cols, rows)';
+    end
+    cams.releaseAlignedFrames();
+end
+cams.disarm();
+
+fprintf("%d aligned frames, %d unmatched frames dropped, %d re-anchorings, %d ring overflows\n", ...
+    numFrames, cams.unalignedFrames(), cams.reanchors(), cams.ringOverflows());
+cams.close();
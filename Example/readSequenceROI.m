@@ -0,0 +1,22 @@
+% Open a sequence recorded with captureFrames(..., 'seq', ...)
+reader = clib.NITCam.SequenceReader();
+if ~reader.open('D:\NITsnap\sequence.seq')
+    error('Cannot open the sequence');
+end
+rows = double(reader.height());
+cols = double(reader.width());
+frames = double(reader.frameCount());
+
+% One full frame (frame numbers start at 0)
+img = reshape(reader.frame16(0, rows * cols), cols, rows).';
+
+% Every 10th frame, 64 x 64 ROI at row 200 / column 300, copied once into MATLAB
+count = floor((frames - 1) / 10) + 1;
+roiRows = 64;
+roiCols = 64;
+[ok, data] = reader.readFrames16(0, count, 10, 200, 300, roiRows, roiCols, count * roiRows * roiCols);
+if ok
+    % C++ layout is frames x rows x columns (row major) -> rows x columns x frames
+    roiStack = permute(reshape(data, roiCols, roiRows, count), [2 1 3]);
+end
+reader.close();
@@ -0,0 +1,356 @@
+/** End-to-end benchmark of the NITCam capture paths                                           **/
+/**                                                                                             **/
+/** Build it as a console application with the NITCam sources. With CAMERA_MODEL               **/
+/** SIMULATED_DEVICE (CameraSelector.h) no camera is needed and runs are comparable between     **/
+/** releases. The results are written as JSON to stdout or to the file given with --output.     **/
+/**                                                                                             **/
+/**   NITCamBenchmark [--frames N] [--dir path] [--output file.json] [--no-live]                 **/
+/**                                                                                             **/
+/** Latency is measured per frame from the moment the frame enters the pipeline (the time       **/
+/** FrameStatistics keeps by frame Id) to the moment it reaches an observer next to the capture **/
+/** sinks, and for the frame ring from the ring to the consumer thread that pops it.            **/
+#include "NITCam.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    double processCpuSeconds()
+    {
+        FILETIME creation, exit, kernel, user;
+        if( !GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user) )
+            return 0.0;
+        // FILETIME counts 100 ns
+        unsigned long long k = ((unsigned long long)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+        unsigned long long u = ((unsigned long long)user.dwHighDateTime << 32) | user.dwLowDateTime;
+        return (k + u) * 1e-7;
+    }
+
+    /** Latency in microseconds between a frame entering the pipeline and this observer seeing it **/
+    class LatencyProbe : public NITObserver
+    {
+        public:
+            explicit LatencyProbe(const FrameStatistics& statistics) : arrivals(statistics) {}
+
+            void reset()
+            {
+                std::lock_guard<std::mutex> lock(probeMutex);
+                latencies.clear();
+            }
+
+            std::vector< double > collect()
+            {
+                std::lock_guard<std::mutex> lock(probeMutex);
+                return latencies;
+            }
+
+        private:
+            const FrameStatistics& arrivals;
+            std::mutex probeMutex;
+            std::vector< double > latencies;
+
+            void onNewFrame(const NITFrame& frame)
+            {
+                Clock::time_point now = Clock::now();
+                // looked up by Id: a dropped or reordered frame only loses its own sample
+                Clock::time_point arrival;
+                if( !arrivals.arrivalTime(frame.Id(), arrival) )
+                    return;
+                std::lock_guard<std::mutex> lock(probeMutex);
+                latencies.push_back(std::chrono::duration<double, std::micro>(now - arrival).count());
+            }
+    };
+
+    struct Result
+    {
+        Result() : frames(0), seconds(0.0), cpuSeconds(0.0), dropped(0), ok(true) {}
+        std::string name;
+        int bitMode;
+        unsigned long long frames;
+        double seconds, cpuSeconds;
+        unsigned long long dropped;
+        bool ok;
+        std::vector< double > latencies;        // microseconds
+        std::string latencyName;
+    };
+
+    double percentile(std::vector< double > sorted, double p)
+    {
+        if( sorted.empty() )
+            return 0.0;
+        size_t rank = (size_t)(p / 100.0 * sorted.size() + 0.5);
+        rank = rank == 0 ? 0 : rank - 1;
+        return sorted[rank < sorted.size() ? rank : sorted.size() - 1];
+    }
+
+    std::string jsonString(const std::string& value)
+    {
+        std::string out = "\"";
+        for( size_t i = 0; i < value.size(); ++i )
+        {
+            char c = value[i];
+            if( c == '"' || c == '\\' )
+                out += '\\';
+            out += (unsigned char)c < 0x20 ? ' ' : c;
+        }
+        return out + "\"";
+    }
+
+    void writeResult(std::ostream& out, const Result& result)
+    {
+        std::vector< double > sorted(result.latencies);
+        std::sort(sorted.begin(), sorted.end());
+        out << "    {\"name\": " << jsonString(result.name)
+            << ", \"bit_mode\": " << result.bitMode
+            << ", \"ok\": " << (result.ok ? "true" : "false")
+            << ", \"frames\": " << result.frames
+            << ", \"seconds\": " << result.seconds
+            << ", \"fps\": " << (result.seconds > 0.0 ? result.frames / result.seconds : 0.0)
+            << ", \"dropped_frames\": " << result.dropped
+            << ", \"cpu_seconds\": " << result.cpuSeconds;
+        if( !result.latencyName.empty() )
+        {
+            out << ", \"" << result.latencyName << "\": {\"count\": " << sorted.size()
+                << ", \"p50\": " << percentile(sorted, 50.0)
+                << ", \"p90\": " << percentile(sorted, 90.0)
+                << ", \"p99\": " << percentile(sorted, 99.0)
+                << ", \"max\": " << (sorted.empty() ? 0.0 : sorted.back()) << "}";
+        }
+        out << "}";
+    }
+
+    class Benchmark
+    {
+        public:
+            Benchmark(NITCam& camera) : cam(camera), probe(camera.frameStatistics())
+            {
+                cam.connectObserver(probe);
+            }
+
+            ~Benchmark()
+            {
+                probe.disconnect();
+            }
+
+            /** Run one capture call and measure it **/
+            template< typename Capture >
+            Result measure(const std::string& name, int bit_mode, unsigned int frames, Capture capture)
+            {
+                Result result;
+                result.name = name;
+                result.bitMode = bit_mode;
+                result.frames = frames;
+                result.latencyName = "pipeline_latency_us";
+
+                unsigned long long dropped = cam.config_observer.droppedFrames();
+                probe.reset();
+                double cpu = processCpuSeconds();
+                Clock::time_point start = Clock::now();
+
+                result.ok = capture();
+
+                result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                result.cpuSeconds = processCpuSeconds() - cpu;
+                result.dropped = cam.config_observer.droppedFrames() - dropped;
+                result.latencies = probe.collect();
+                return result;
+            }
+
+            /** Stream into the frame ring and pop from a consumer thread for the given time **/
+            Result ring(int bit_mode, unsigned int slots, double seconds)
+            {
+                Result result;
+                result.name = "frame_ring";
+                result.bitMode = bit_mode;
+                result.latencyName = "ring_to_consumer_latency_us";
+
+                unsigned long long dropped = cam.config_observer.droppedFrames();
+                double cpu = processCpuSeconds();
+                Clock::time_point start = Clock::now();
+                Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+
+                result.ok = cam.startFrameRing(slots, bit_mode);
+                FrameRing& frame_ring = cam.ring();
+                while( result.ok && Clock::now() < end )
+                {
+                    const FrameRing::Slot* slot = frame_ring.front();
+                    if( slot == NULL )
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - slot->received).count());
+                    frame_ring.pop();
+                    ++result.frames;
+                }
+                cam.stopFrameRing();
+                while( frame_ring.front() != NULL )
+                    frame_ring.pop();
+
+                result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                result.cpuSeconds = processCpuSeconds() - cpu;
+                result.dropped = cam.config_observer.droppedFrames() - dropped + frame_ring.overflows();
+                return result;
+            }
+
+            /** Start and stop the live view, frames counts the start/stop pairs **/
+            Result liveView(unsigned int repetitions)
+            {
+                Result result;
+                result.name = "live_view_start_stop";
+                result.bitMode = 2;
+                result.frames = repetitions;
+                result.latencyName = "start_stop_us";
+
+                double cpu = processCpuSeconds();
+                Clock::time_point start = Clock::now();
+                for( unsigned int i = 0; i < repetitions; ++i )
+                {
+                    Clock::time_point t = Clock::now();
+                    cam.startLiveImage();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    cam.stopLiveImage();
+                    // without the time the live view was shown
+                    result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t).count() - 20000.0);
+                }
+                result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                result.cpuSeconds = processCpuSeconds() - cpu;
+                return result;
+            }
+
+            /** Alternate the exposure time, frames counts the updates **/
+            Result parameterUpdates(unsigned int repetitions)
+            {
+                Result result;
+                result.name = "parameter_update";
+                result.bitMode = 0;
+                result.frames = repetitions;
+                result.latencyName = "update_us";
+
+                double exposure = cam.dev->paramValueOf("Exposure Time");
+                double cpu = processCpuSeconds();
+                Clock::time_point start = Clock::now();
+                try
+                {
+                    for( unsigned int i = 0; i < repetitions; ++i )
+                    {
+                        Clock::time_point t = Clock::now();
+                        cam.dev->setParamValueOf("Exposure Time", i % 2 == 0 ? exposure * 2.0 : exposure);
+                        cam.dev->updateConfig();
+                        result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t).count());
+                    }
+                    cam.dev->setParamValueOf("Exposure Time", exposure);
+                    cam.dev->updateConfig();
+                }
+                catch( NITException& exc )
+                {
+                    std::cerr << "NITException: " << exc.what() << std::endl;
+                    result.ok = false;
+                }
+                result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                result.cpuSeconds = processCpuSeconds() - cpu;
+                return result;
+            }
+
+        private:
+            NITCam& cam;
+            LatencyProbe probe;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int frames = 500;
+    std::string directory = ".";
+    std::string output;
+    bool live = true;
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        if( arg == "--frames" && i + 1 < argc )
+            frames = (unsigned int)std::atoi(argv[++i]);
+        else if( arg == "--dir" && i + 1 < argc )
+            directory = argv[++i];
+        else if( arg == "--output" && i + 1 < argc )
+            output = argv[++i];
+        else if( arg == "--no-live" )
+            live = false;
+        else
+        {
+            std::cerr << "usage: NITCamBenchmark [--frames N] [--dir path] [--output file.json] [--no-live]" << std::endl;
+            return 1;
+        }
+    }
+
+    // the camera logs to cout, keep it away from the JSON
+    std::ostringstream camera_log;
+    std::streambuf* cout_buffer = std::cout.rdbuf(camera_log.rdbuf());
+
+    std::vector< Result > results;
+    std::string model;
+    unsigned int width = 0, height = 0;
+    double fps = 0.0;
+    {
+        NITCam cam;
+        if( cam.dev == NULL )
+        {
+            std::cout.rdbuf(cout_buffer);
+            std::cerr << "No device" << std::endl;
+            return 1;
+        }
+        model = cam.dev->commercialName();
+        width = (unsigned int)cam.dev->paramValueOf("NumberOfColumns");
+        height = (unsigned int)cam.dev->paramValueOf("Number of Lines");
+        fps = cam.dev->fps();
+        double exposure = cam.dev->paramValueOf("Exposure Time");
+
+        Benchmark bench(cam);
+        // snapshot writes one file per frame, keep it shorter
+        unsigned int snapshot_frames = frames / 10 > 0 ? frames / 10 : 1;
+        for( int bit_mode = 0; bit_mode < 3; ++bit_mode )
+        {
+            results.push_back(bench.measure("capture_to_memory", bit_mode, frames, [&] {
+                return cam.captureFramesToMemory(false, bit_mode, 0.0, exposure, frames);
+            }));
+            results.push_back(bench.measure("capture_sequence_file", bit_mode, frames, [&] {
+                return cam.captureFrames(directory, "benchmark", "seq", false, bit_mode, 0.0, exposure, frames);
+            }));
+            results.push_back(bench.measure("capture_snapshot_files", bit_mode, snapshot_frames, [&] {
+                return cam.captureFrames(directory, "benchmark", "tif", false, bit_mode, 0.0, exposure, snapshot_frames);
+            }));
+        }
+        results.push_back(bench.ring(0, 32, frames / (fps > 0.0 ? fps : 100.0)));
+        results.push_back(bench.parameterUpdates(100));
+        if( live )
+            results.push_back(bench.liveView(10));
+    }
+    std::cout.rdbuf(cout_buffer);
+
+    std::ofstream file;
+    if( !output.empty() )
+    {
+        file.open(output.c_str());
+        if( !file )
+        {
+            std::cerr << "Can't write " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"device\": {\"name\": " << jsonString(model) << ", \"width\": " << width << ", \"height\": " << height
+        << ", \"fps\": " << fps << "},\n  \"results\": [\n";
+    for( size_t i = 0; i < results.size(); ++i )
+    {
+        writeResult(out, results[i]);
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return 0;
+}
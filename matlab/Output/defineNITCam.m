@@ -55,6 +55,16 @@ NITCamConstructor1Definition = addConstructor(NITCamDefinition, ...
     "Description", "clib.NITCam.NITCam Constructor of C++ class NITCam."); % Modify help description values as needed.
 validate(NITCamConstructor1Definition);
 
+%% C++ class constructor for C++ class |NITCam| 
+% C++ Signature: NITCam::NITCam(std::string const serialNumber)
+
+NITCamConstructor2Definition = addConstructor(NITCamDefinition, ...
+    "NITCam::NITCam(std::string const serialNumber)", ...
+    "Description", "clib.NITCam.NITCam Constructor of C++ class NITCam." + newline + ...
+    "Connect to the camera with the given serial number instead of the first one"); % Modify help description values as needed.
+defineArgument(NITCamConstructor2Definition, "serialNumber", "string");
+validate(NITCamConstructor2Definition);
+
 %% C++ class method |activateTriggerMode| for C++ class |NITCam| 
 % C++ Signature: void NITCam::activateTriggerMode(bool state)
 
@@ -65,6 +75,31 @@ activateTriggerModeDefinition = addMethod(NITCamDefinition, ...
 defineArgument(activateTriggerModeDefinition, "state", "logical");
 validate(activateTriggerModeDefinition);
 
+%% C++ class method |configure| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::configure(bool gatedMode,double triggerDelayInput,double exposureTime)
+
+configureDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::configure(bool gatedMode,double triggerDelayInput,double exposureTime)", ...
+    "MATLABName", "configure", ...
+    "Description", "configure Method of C++ class NITCam." + newline + ...
+    "Set the mode, trigger delay and exposure time of the following captures without capturing"); % Modify help description values as needed.
+defineArgument(configureDefinition, "gatedMode", "logical");
+defineArgument(configureDefinition, "triggerDelayInput", "double");
+defineArgument(configureDefinition, "exposureTime", "double");
+defineOutput(configureDefinition, "RetVal", "logical");
+validate(configureDefinition);
+
+%% C++ class method |serialNumber| for C++ class |NITCam| 
+% C++ Signature: std::string NITCam::serialNumber()
+
+NITCamSerialNumberDefinition = addMethod(NITCamDefinition, ...
+    "std::string NITCam::serialNumber()", ...
+    "MATLABName", "serialNumber", ...
+    "Description", "serialNumber Method of C++ class NITCam." + newline + ...
+    "Serial number of the connected camera, empty if there is none"); % Modify help description values as needed.
+defineOutput(NITCamSerialNumberDefinition, "RetVal", "string");
+validate(NITCamSerialNumberDefinition);
+
 %% C++ class method |captureFrames| for C++ class |NITCam| 
 % C++ Signature: bool NITCam::captureFrames(std::string const saveDirectory,std::string const fileName,std::string const fileType,bool gatedMode,int bitMode,double inputTriggerDelay,double exposureTime,int numOfFramesToCapture)
 
@@ -87,6 +122,567 @@ defineArgument(captureFramesDefinition, "numOfFramesToCapture", "int32");
 defineOutput(captureFramesDefinition, "RetVal", "logical");
 validate(captureFramesDefinition);
 
+%% C++ class method |captureFramesToMemory| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::captureFramesToMemory(bool gatedMode,int bitMode,double triggerDelayInput,double exposureTime,int numOfFramesToCapture)
+
+captureFramesToMemoryDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::captureFramesToMemory(bool gatedMode,int bitMode,double triggerDelayInput,double exposureTime,int numOfFramesToCapture)", ...
+    "MATLABName", "captureFramesToMemory", ...
+    "Description", "captureFramesToMemory Method of C++ class NITCam." + newline + ...
+    "Capture frames into memory instead of files", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Same parameters as captureFrames. The frames are kept in one contiguous buffer (frames x rows x columns, row major)" + newline + ...
+    "as uint16 for bitMode 0 and uint8 for bitMode 1 and 2. Use frameData16 / frameData8 to get them into MATLAB."); % Modify help description values as needed.
+defineArgument(captureFramesToMemoryDefinition, "gatedMode", "logical");
+defineArgument(captureFramesToMemoryDefinition, "bitMode", "int32");
+defineArgument(captureFramesToMemoryDefinition, "triggerDelayInput", "double");
+defineArgument(captureFramesToMemoryDefinition, "exposureTime", "double");
+defineArgument(captureFramesToMemoryDefinition, "numOfFramesToCapture", "int32");
+defineOutput(captureFramesToMemoryDefinition, "RetVal", "logical");
+validate(captureFramesToMemoryDefinition);
+
+%% C++ class method |startCapture| for C++ class |NITCam| 
+% C++ Signature: int NITCam::startCapture(bool gatedMode,int bitMode,double triggerDelayInput,double exposureTime,int numOfFramesToCapture)
+
+startCaptureDefinition = addMethod(NITCamDefinition, ...
+    "int NITCam::startCapture(bool gatedMode,int bitMode,double triggerDelayInput,double exposureTime,int numOfFramesToCapture)", ...
+    "MATLABName", "startCapture", ...
+    "Description", "startCapture Method of C++ class NITCam." + newline + ...
+    "Start a memory capture on a background thread and return at once", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Same parameters as captureFramesToMemory. Returns a handle (> 0), or 0 if the last capture is still running." + newline + ...
+    "The frames go into a second preallocated buffer: capturedFrames and frameData16 / frameData8 / frameDataSingle" + newline + ...
+    "keep returning the previous capture until fetch is called. Other captures wait for a running one to finish and" + newline + ...
+    "replace its unfetched frames. Don't change camera settings while a capture runs."); % Modify help description values as needed.
+defineArgument(startCaptureDefinition, "gatedMode", "logical");
+defineArgument(startCaptureDefinition, "bitMode", "int32");
+defineArgument(startCaptureDefinition, "triggerDelayInput", "double");
+defineArgument(startCaptureDefinition, "exposureTime", "double");
+defineArgument(startCaptureDefinition, "numOfFramesToCapture", "int32");
+defineOutput(startCaptureDefinition, "RetVal", "int32");
+validate(startCaptureDefinition);
+
+%% C++ class method |isDone| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::isDone(int handle)
+
+isDoneDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::isDone(int handle)", ...
+    "MATLABName", "isDone", ...
+    "Description", "isDone Method of C++ class NITCam." + newline + ...
+    "True once the capture of handle has finished"); % Modify help description values as needed.
+defineArgument(isDoneDefinition, "handle", "int32");
+defineOutput(isDoneDefinition, "RetVal", "logical");
+validate(isDoneDefinition);
+
+%% C++ class method |wait| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::wait(int handle,int timeoutMs)
+
+waitDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::wait(int handle,int timeoutMs)", ...
+    "MATLABName", "wait", ...
+    "Description", "wait Method of C++ class NITCam." + newline + ...
+    "Wait at most timeoutMs milliseconds (negative: no limit) for the capture, true if it has finished"); % Modify help description values as needed.
+defineArgument(waitDefinition, "handle", "int32");
+defineArgument(waitDefinition, "timeoutMs", "int32");
+defineOutput(waitDefinition, "RetVal", "logical");
+validate(waitDefinition);
+
+%% C++ class method |fetch| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::fetch(int handle)
+
+fetchDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::fetch(int handle)", ...
+    "MATLABName", "fetch", ...
+    "Description", "fetch Method of C++ class NITCam." + newline + ...
+    "Wait for the capture and make its frames the captured ones", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Returns the result of the capture, false as well if the handle was fetched already or its frames were replaced."); % Modify help description values as needed.
+defineArgument(fetchDefinition, "handle", "int32");
+defineOutput(fetchDefinition, "RetVal", "logical");
+validate(fetchDefinition);
+
+%% C++ class method |captureDelaySweep| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::captureDelaySweep(bool gatedMode,int bitMode,double const * triggerDelays,double const * exposureTimes,int const * framesPerStep,int numSteps)
+
+captureDelaySweepDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::captureDelaySweep(bool gatedMode,int bitMode,double const * triggerDelays,double const * exposureTimes,int const * framesPerStep,int numSteps)", ...
+    "MATLABName", "captureDelaySweep", ...
+    "Description", "captureDelaySweep Method of C++ class NITCam." + newline + ...
+    "Capture a trigger delay sweep into memory", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "For each of the numSteps steps the trigger delay and exposure time are set and framesPerStep frames are averaged" + newline + ...
+    "into one slice of a delay x rows x columns volume. Read it with capturedFrames (= steps) and frameData16 / frameData8." + newline + ...
+    "Only the parameters that change between steps are sent to the camera."); % Modify help description values as needed.
+defineArgument(captureDelaySweepDefinition, "gatedMode", "logical");
+defineArgument(captureDelaySweepDefinition, "bitMode", "int32");
+defineArgument(captureDelaySweepDefinition, "triggerDelays", "double", "input", "numSteps");
+defineArgument(captureDelaySweepDefinition, "exposureTimes", "double", "input", "numSteps");
+defineArgument(captureDelaySweepDefinition, "framesPerStep", "int32", "input", "numSteps");
+defineArgument(captureDelaySweepDefinition, "numSteps", "int32");
+defineOutput(captureDelaySweepDefinition, "RetVal", "logical");
+validate(captureDelaySweepDefinition);
+
+%% C++ class method |reconstructRange| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::reconstructRange(int method,float minIntensity)
+
+reconstructRangeDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::reconstructRange(int method,float minIntensity)", ...
+    "MATLABName", "reconstructRange", ...
+    "Description", "reconstructRange Method of C++ class NITCam." + newline + ...
+    "Compute per-pixel range and peak intensity from the last delay sweep", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "int method: 0 = peak step, 1 = centroid, 2 = parabolic fit" + newline + ...
+    "Pixels with a peak below minIntensity get NaN as range."); % Modify help description values as needed.
+defineArgument(reconstructRangeDefinition, "method", "int32");
+defineArgument(reconstructRangeDefinition, "minIntensity", "single");
+defineOutput(reconstructRangeDefinition, "RetVal", "logical");
+validate(reconstructRangeDefinition);
+
+%% C++ class method |rangeMap| for C++ class |NITCam| 
+% C++ Signature: float const * NITCam::rangeMap(size_t numel)
+
+rangeMapDefinition = addMethod(NITCamDefinition, ...
+    "float const * NITCam::rangeMap(size_t numel)", ...
+    "MATLABName", "rangeMap", ...
+    "Description", "rangeMap Method of C++ class NITCam." + newline + ...
+    "Return the range map in metres (rows x columns, row major)"); % Modify help description values as needed.
+defineArgument(rangeMapDefinition, "numel", "uint64");
+defineOutput(rangeMapDefinition, "RetVal", "single", "numel");
+validate(rangeMapDefinition);
+
+%% C++ class method |intensityMap| for C++ class |NITCam| 
+% C++ Signature: float const * NITCam::intensityMap(size_t numel)
+
+intensityMapDefinition = addMethod(NITCamDefinition, ...
+    "float const * NITCam::intensityMap(size_t numel)", ...
+    "MATLABName", "intensityMap", ...
+    "Description", "intensityMap Method of C++ class NITCam." + newline + ...
+    "Return the peak intensity map (rows x columns, row major)"); % Modify help description values as needed.
+defineArgument(intensityMapDefinition, "numel", "uint64");
+defineOutput(intensityMapDefinition, "RetVal", "single", "numel");
+validate(intensityMapDefinition);
+
+%% C++ class method |capturedFrames| for C++ class |NITCam| 
+% C++ Signature: unsigned int NITCam::capturedFrames()
+
+capturedFramesDefinition = addMethod(NITCamDefinition, ...
+    "unsigned int NITCam::capturedFrames()", ...
+    "MATLABName", "capturedFrames", ...
+    "Description", "capturedFrames Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(capturedFramesDefinition, "RetVal", "uint32");
+validate(capturedFramesDefinition);
+
+%% C++ class method |capturedRows| for C++ class |NITCam| 
+% C++ Signature: unsigned int NITCam::capturedRows()
+
+capturedRowsDefinition = addMethod(NITCamDefinition, ...
+    "unsigned int NITCam::capturedRows()", ...
+    "MATLABName", "capturedRows", ...
+    "Description", "capturedRows Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(capturedRowsDefinition, "RetVal", "uint32");
+validate(capturedRowsDefinition);
+
+%% C++ class method |capturedColumns| for C++ class |NITCam| 
+% C++ Signature: unsigned int NITCam::capturedColumns()
+
+capturedColumnsDefinition = addMethod(NITCamDefinition, ...
+    "unsigned int NITCam::capturedColumns()", ...
+    "MATLABName", "capturedColumns", ...
+    "Description", "capturedColumns Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(capturedColumnsDefinition, "RetVal", "uint32");
+validate(capturedColumnsDefinition);
+
+%% C++ class method |frameData16| for C++ class |NITCam| 
+% C++ Signature: unsigned short const * NITCam::frameData16(size_t numel)
+
+frameData16Definition = addMethod(NITCamDefinition, ...
+    "unsigned short const * NITCam::frameData16(size_t numel)", ...
+    "MATLABName", "frameData16", ...
+    "Description", "frameData16 Method of C++ class NITCam." + newline + ...
+    "Return the pixels of the last 14-bit memory capture", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "numel must be capturedFrames() * capturedRows() * capturedColumns(), else NULL is returned."); % Modify help description values as needed.
+defineArgument(frameData16Definition, "numel", "uint64");
+defineOutput(frameData16Definition, "RetVal", "uint16", "numel");
+validate(frameData16Definition);
+
+%% C++ class method |frameData8| for C++ class |NITCam| 
+% C++ Signature: unsigned char const * NITCam::frameData8(size_t numel)
+
+frameData8Definition = addMethod(NITCamDefinition, ...
+    "unsigned char const * NITCam::frameData8(size_t numel)", ...
+    "MATLABName", "frameData8", ...
+    "Description", "frameData8 Method of C++ class NITCam." + newline + ...
+    "Return the pixels of the last 8-bit memory capture", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "numel must be capturedFrames() * capturedRows() * capturedColumns(), else NULL is returned."); % Modify help description values as needed.
+defineArgument(frameData8Definition, "numel", "uint64");
+defineOutput(frameData8Definition, "RetVal", "uint8", "numel");
+validate(frameData8Definition);
+
+%% C++ class method |frameDataSingle| for C++ class |NITCam| 
+% C++ Signature: float const * NITCam::frameDataSingle(size_t numel)
+
+frameDataSingleDefinition = addMethod(NITCamDefinition, ...
+    "float const * NITCam::frameDataSingle(size_t numel)", ...
+    "MATLABName", "frameDataSingle", ...
+    "Description", "frameDataSingle Method of C++ class NITCam." + newline + ...
+    "Return the pixels of the last memory capture stored as single, see setMemoryFormat", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "numel must be capturedFrames() * capturedRows() * capturedColumns(), else NULL is returned."); % Modify help description values as needed.
+defineArgument(frameDataSingleDefinition, "numel", "uint64");
+defineOutput(frameDataSingleDefinition, "RetVal", "single", "numel");
+validate(frameDataSingleDefinition);
+
+%% C++ class method |setMemoryFormat| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setMemoryFormat(bool columnMajor,bool singlePrecision)
+
+setMemoryFormatDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setMemoryFormat(bool columnMajor,bool singlePrecision)", ...
+    "MATLABName", "setMemoryFormat", ...
+    "Description", "setMemoryFormat Method of C++ class NITCam." + newline + ...
+    "Choose the layout and class of the following memory captures and delay sweeps", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "columnMajor: each frame is stored column major, the MATLAB layout. reshape(data, capturedRows, capturedColumns, frames)" + newline + ...
+    "gives the images without a permute, the conversion and the transpose run in one pass as the frames arrive." + newline + ...
+    "The range and intensity maps of a column major sweep are column major as well." + newline + ...
+    "columnMajor is refused while setTransform(4) is active, the two would transpose twice." + newline + ...
+    "singlePrecision: the pixels are kept as single (frameDataSingle) instead of uint16 (bitMode 0) or uint8, so" + newline + ...
+    "averaged sweep steps keep their fractions."); % Modify help description values as needed.
+defineArgument(setMemoryFormatDefinition, "columnMajor", "logical");
+defineArgument(setMemoryFormatDefinition, "singlePrecision", "logical");
+validate(setMemoryFormatDefinition);
+
+%% C++ class method |metadataFrames| for C++ class |NITCam| 
+% C++ Signature: unsigned int NITCam::metadataFrames()
+
+metadataFramesDefinition = addMethod(NITCamDefinition, ...
+    "unsigned int NITCam::metadataFrames()", ...
+    "MATLABName", "metadataFrames", ...
+    "Description", "metadataFrames Method of C++ class NITCam." + newline + ...
+    "Number of frames described by the metadata of the last memory capture or delay sweep", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Every frame that reached the memory gets one row: its Id, the host receive time, the sensor temperature and" + newline + ...
+    "timestamp and the settings it was taken with. In a sweep each averaged frame has its own row. Gaps in the Ids" + newline + ...
+    "show dropped frames. Each column is read with its own function, numel must be metadataFrames()."); % Modify help description values as needed.
+defineOutput(metadataFramesDefinition, "RetVal", "uint32");
+validate(metadataFramesDefinition);
+
+%% C++ class method |metadataIds| for C++ class |NITCam| 
+% C++ Signature: unsigned long long const * NITCam::metadataIds(size_t numel)
+
+metadataIdsDefinition = addMethod(NITCamDefinition, ...
+    "unsigned long long const * NITCam::metadataIds(size_t numel)", ...
+    "MATLABName", "metadataIds", ...
+    "Description", "metadataIds Method of C++ class NITCam."); % Modify help description values as needed.
+defineArgument(metadataIdsDefinition, "numel", "uint64");
+defineOutput(metadataIdsDefinition, "RetVal", "uint64", "numel");
+validate(metadataIdsDefinition);
+
+%% C++ class method |metadataHostTimes| for C++ class |NITCam| 
+% C++ Signature: double const * NITCam::metadataHostTimes(size_t numel)
+
+metadataHostTimesDefinition = addMethod(NITCamDefinition, ...
+    "double const * NITCam::metadataHostTimes(size_t numel)", ...
+    "MATLABName", "metadataHostTimes", ...
+    "Description", "metadataHostTimes Method of C++ class NITCam." + newline + ...
+    "Host times the frames entered the pipeline, seconds on the monotonic clock, only differences are meaningful"); % Modify help description values as needed.
+defineArgument(metadataHostTimesDefinition, "numel", "uint64");
+defineOutput(metadataHostTimesDefinition, "RetVal", "double", "numel");
+validate(metadataHostTimesDefinition);
+
+%% C++ class method |metadataTemperatures| for C++ class |NITCam| 
+% C++ Signature: float const * NITCam::metadataTemperatures(size_t numel)
+
+metadataTemperaturesDefinition = addMethod(NITCamDefinition, ...
+    "float const * NITCam::metadataTemperatures(size_t numel)", ...
+    "MATLABName", "metadataTemperatures", ...
+    "Description", "metadataTemperatures Method of C++ class NITCam."); % Modify help description values as needed.
+defineArgument(metadataTemperaturesDefinition, "numel", "uint64");
+defineOutput(metadataTemperaturesDefinition, "RetVal", "single", "numel");
+validate(metadataTemperaturesDefinition);
+
+%% C++ class method |metadataTimestamps| for C++ class |NITCam| 
+% C++ Signature: double const * NITCam::metadataTimestamps(size_t numel)
+
+metadataTimestampsDefinition = addMethod(NITCamDefinition, ...
+    "double const * NITCam::metadataTimestamps(size_t numel)", ...
+    "MATLABName", "metadataTimestamps", ...
+    "Description", "metadataTimestamps Method of C++ class NITCam."); % Modify help description values as needed.
+defineArgument(metadataTimestampsDefinition, "numel", "uint64");
+defineOutput(metadataTimestampsDefinition, "RetVal", "double", "numel");
+validate(metadataTimestampsDefinition);
+
+%% C++ class method |metadataExposureTimes| for C++ class |NITCam| 
+% C++ Signature: double const * NITCam::metadataExposureTimes(size_t numel)
+
+metadataExposureTimesDefinition = addMethod(NITCamDefinition, ...
+    "double const * NITCam::metadataExposureTimes(size_t numel)", ...
+    "MATLABName", "metadataExposureTimes", ...
+    "Description", "metadataExposureTimes Method of C++ class NITCam." + newline + ...
+    "Requested exposure times in us"); % Modify help description values as needed.
+defineArgument(metadataExposureTimesDefinition, "numel", "uint64");
+defineOutput(metadataExposureTimesDefinition, "RetVal", "double", "numel");
+validate(metadataExposureTimesDefinition);
+
+%% C++ class method |metadataTriggerDelays| for C++ class |NITCam| 
+% C++ Signature: double const * NITCam::metadataTriggerDelays(size_t numel)
+
+metadataTriggerDelaysDefinition = addMethod(NITCamDefinition, ...
+    "double const * NITCam::metadataTriggerDelays(size_t numel)", ...
+    "MATLABName", "metadataTriggerDelays", ...
+    "Description", "metadataTriggerDelays Method of C++ class NITCam." + newline + ...
+    "Requested trigger delays in us"); % Modify help description values as needed.
+defineArgument(metadataTriggerDelaysDefinition, "numel", "uint64");
+defineOutput(metadataTriggerDelaysDefinition, "RetVal", "double", "numel");
+validate(metadataTriggerDelaysDefinition);
+
+%% C++ class method |metadataGatedModes| for C++ class |NITCam| 
+% C++ Signature: unsigned char const * NITCam::metadataGatedModes(size_t numel)
+
+metadataGatedModesDefinition = addMethod(NITCamDefinition, ...
+    "unsigned char const * NITCam::metadataGatedModes(size_t numel)", ...
+    "MATLABName", "metadataGatedModes", ...
+    "Description", "metadataGatedModes Method of C++ class NITCam." + newline + ...
+    "1 for gated frames, 0 for global shutter"); % Modify help description values as needed.
+defineArgument(metadataGatedModesDefinition, "numel", "uint64");
+defineOutput(metadataGatedModesDefinition, "RetVal", "uint8", "numel");
+validate(metadataGatedModesDefinition);
+
+%% C++ class method |writeMetadata| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::writeMetadata(std::string const fileName)
+
+writeMetadataDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::writeMetadata(std::string const fileName)", ...
+    "MATLABName", "writeMetadata", ...
+    "Description", "writeMetadata Method of C++ class NITCam." + newline + ...
+    "Write the metadata of the last memory capture to a binary sidecar, see readNITMetadata.m"); % Modify help description values as needed.
+defineArgument(writeMetadataDefinition, "fileName", "string");
+defineOutput(writeMetadataDefinition, "RetVal", "logical");
+validate(writeMetadataDefinition);
+
+%% C++ class method |setMetadataSidecar| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setMetadataSidecar(bool state)
+
+setMetadataSidecarDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setMetadataSidecar(bool state)", ...
+    "MATLABName", "setMetadataSidecar", ...
+    "Description", "setMetadataSidecar Method of C++ class NITCam." + newline + ...
+    "Write saveDirectory/fileName.meta next to the files of each following captureFrames"); % Modify help description values as needed.
+defineArgument(setMetadataSidecarDefinition, "state", "logical");
+validate(setMetadataSidecarDefinition);
+
+%% C++ class method |startFrameRing| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::startFrameRing(unsigned int slotCount,int bitMode)
+
+startFrameRingDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::startFrameRing(unsigned int slotCount,int bitMode)", ...
+    "MATLABName", "startFrameRing", ...
+    "Description", "startFrameRing Method of C++ class NITCam." + newline + ...
+    "Stream continuously into a ring of slotCount preallocated frames", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "The streaming thread never waits for the consumer, frames arriving while the ring is full are dropped" + newline + ...
+    "and counted in ringOverflows(). Read the oldest frame with ringFrameData16 (bitMode 0) or" + newline + ...
+    "ringFrameData8 (gain controlled modes) and ringFrameId and release it" + newline + ...
+    "with releaseRingFrame."); % Modify help description values as needed.
+defineArgument(startFrameRingDefinition, "slotCount", "uint32");
+defineArgument(startFrameRingDefinition, "bitMode", "int32");
+defineOutput(startFrameRingDefinition, "RetVal", "logical");
+validate(startFrameRingDefinition);
+
+%% C++ class method |stopFrameRing| for C++ class |NITCam| 
+% C++ Signature: void NITCam::stopFrameRing()
+
+stopFrameRingDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::stopFrameRing()", ...
+    "MATLABName", "stopFrameRing", ...
+    "Description", "stopFrameRing Method of C++ class NITCam."); % Modify help description values as needed.
+validate(stopFrameRingDefinition);
+
+%% C++ class method |ringAvailable| for C++ class |NITCam| 
+% C++ Signature: unsigned int NITCam::ringAvailable()
+
+ringAvailableDefinition = addMethod(NITCamDefinition, ...
+    "unsigned int NITCam::ringAvailable()", ...
+    "MATLABName", "ringAvailable", ...
+    "Description", "ringAvailable Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(ringAvailableDefinition, "RetVal", "uint32");
+validate(ringAvailableDefinition);
+
+%% C++ class method |ringOverflows| for C++ class |NITCam| 
+% C++ Signature: unsigned long long NITCam::ringOverflows()
+
+ringOverflowsDefinition = addMethod(NITCamDefinition, ...
+    "unsigned long long NITCam::ringOverflows()", ...
+    "MATLABName", "ringOverflows", ...
+    "Description", "ringOverflows Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(ringOverflowsDefinition, "RetVal", "uint64");
+validate(ringOverflowsDefinition);
+
+%% C++ class method |ringFrameData16| for C++ class |NITCam| 
+% C++ Signature: unsigned short const * NITCam::ringFrameData16(size_t numel)
+
+ringFrameData16Definition = addMethod(NITCamDefinition, ...
+    "unsigned short const * NITCam::ringFrameData16(size_t numel)", ...
+    "MATLABName", "ringFrameData16", ...
+    "Description", "ringFrameData16 Method of C++ class NITCam." + newline + ...
+    "Return the pixels of the oldest queued frame (rows x columns, row major)" + newline + ...
+    "NULL if the ring is empty or holds the other pixel type."); % Modify help description values as needed.
+defineArgument(ringFrameData16Definition, "numel", "uint64");
+defineOutput(ringFrameData16Definition, "RetVal", "uint16", "numel");
+validate(ringFrameData16Definition);
+
+%% C++ class method |ringFrameData8| for C++ class |NITCam| 
+% C++ Signature: unsigned char const * NITCam::ringFrameData8(size_t numel)
+
+ringFrameData8Definition = addMethod(NITCamDefinition, ...
+    "unsigned char const * NITCam::ringFrameData8(size_t numel)", ...
+    "MATLABName", "ringFrameData8", ...
+    "Description", "ringFrameData8 Method of C++ class NITCam." + newline + ...
+    "Return the pixels of the oldest queued frame (rows x columns, row major)" + newline + ...
+    "NULL if the ring is empty or holds the other pixel type."); % Modify help description values as needed.
+defineArgument(ringFrameData8Definition, "numel", "uint64");
+defineOutput(ringFrameData8Definition, "RetVal", "uint8", "numel");
+validate(ringFrameData8Definition);
+
+%% C++ class method |ringFrameId| for C++ class |NITCam| 
+% C++ Signature: unsigned long long NITCam::ringFrameId()
+
+ringFrameIdDefinition = addMethod(NITCamDefinition, ...
+    "unsigned long long NITCam::ringFrameId()", ...
+    "MATLABName", "ringFrameId", ...
+    "Description", "ringFrameId Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(ringFrameIdDefinition, "RetVal", "uint64");
+validate(ringFrameIdDefinition);
+
+%% C++ class method |ringFrameTemperature| for C++ class |NITCam| 
+% C++ Signature: float NITCam::ringFrameTemperature()
+
+ringFrameTemperatureDefinition = addMethod(NITCamDefinition, ...
+    "float NITCam::ringFrameTemperature()", ...
+    "MATLABName", "ringFrameTemperature", ...
+    "Description", "ringFrameTemperature Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(ringFrameTemperatureDefinition, "RetVal", "single");
+validate(ringFrameTemperatureDefinition);
+
+%% C++ class method |ringFrameTimestamp| for C++ class |NITCam| 
+% C++ Signature: double NITCam::ringFrameTimestamp()
+
+ringFrameTimestampDefinition = addMethod(NITCamDefinition, ...
+    "double NITCam::ringFrameTimestamp()", ...
+    "MATLABName", "ringFrameTimestamp", ...
+    "Description", "ringFrameTimestamp Method of C++ class NITCam."); % Modify help description values as needed.
+defineOutput(ringFrameTimestampDefinition, "RetVal", "double");
+validate(ringFrameTimestampDefinition);
+
+%% C++ class method |releaseRingFrame| for C++ class |NITCam| 
+% C++ Signature: void NITCam::releaseRingFrame()
+
+releaseRingFrameDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::releaseRingFrame()", ...
+    "MATLABName", "releaseRingFrame", ...
+    "Description", "releaseRingFrame Method of C++ class NITCam." + newline + ...
+    "Hand the oldest queued frame back to the ring"); % Modify help description values as needed.
+validate(releaseRingFrameDefinition);
+
+%% C++ class method |ring| for C++ class |NITCam| 
+% C++ Signature: FrameRing & NITCam::ring()
+
+%ringDefinition = addMethod(NITCamDefinition, ...
+%    "FrameRing & NITCam::ring()", ...
+%    "MATLABName", "ring", ...
+%    "Description", "ring Method of C++ class NITCam." + newline + ...
+%    "Direct access for C++ consumers"); % Modify help description values as needed.
+%defineOutput(ringDefinition, "RetVal", "clib.NITCam.FrameRing", <SHAPE>);
+%validate(ringDefinition);
+
+%% C++ class method |connectObserver| for C++ class |NITCam| 
+% C++ Signature: void NITCam::connectObserver(NITLibrary::NITObserver & observer)
+
+%connectObserverDefinition = addMethod(NITCamDefinition, ...
+%    "void NITCam::connectObserver(NITLibrary::NITObserver & observer)", ...
+%    "MATLABName", "connectObserver", ...
+%    "Description", "connectObserver Method of C++ class NITCam." + newline + ...
+%    "Connect a C++ observer next to the capture sinks (after the gain control)"); % Modify help description values as needed.
+%defineArgument(connectObserverDefinition, "observer", "clib.NITCam.NITLibrary.NITObserver", "input");
+%validate(connectObserverDefinition);
+
+%% C++ class method |statisticsSnapshot| for C++ class |NITCam| 
+% C++ Signature: double const * NITCam::statisticsSnapshot(size_t numel)
+
+statisticsSnapshotDefinition = addMethod(NITCamDefinition, ...
+    "double const * NITCam::statisticsSnapshot(size_t numel)", ...
+    "MATLABName", "statisticsSnapshot", ...
+    "Description", "statisticsSnapshot Method of C++ class NITCam." + newline + ...
+    "Snapshot of the stream statistics since the last resetStatistics", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "numel must be 12. The fields are: 1 frames that reached the pipeline, 2 gaps in the frame Ids," + newline + ...
+    "3 frames missing in the gaps, 4 largest gap, 5 Id resets, 6 last frame Id, 7 mean frame interval (ms)," + newline + ...
+    "8 interval jitter (standard deviation, ms), 9 min and 10 max interval (ms), 11 frames the device reported as" + newline + ...
+    "received and 12 as dropped. Intervals and gaps between two captures are not counted. The snapshot is taken" + newline + ...
+    "without blocking the stream and can be polled while streaming."); % Modify help description values as needed.
+defineArgument(statisticsSnapshotDefinition, "numel", "uint64");
+defineOutput(statisticsSnapshotDefinition, "RetVal", "double", "numel");
+validate(statisticsSnapshotDefinition);
+
+%% C++ class method |statusCount| for C++ class |NITCam| 
+% C++ Signature: unsigned long long NITCam::statusCount(int status)
+
+statusCountDefinition = addMethod(NITCamDefinition, ...
+    "unsigned long long NITCam::statusCount(int status)", ...
+    "MATLABName", "statusCount", ...
+    "Description", "statusCount Method of C++ class NITCam." + newline + ...
+    "Frames the device reported with this status since the last resetStatistics, 0 = ok"); % Modify help description values as needed.
+defineArgument(statusCountDefinition, "status", "int32");
+defineOutput(statusCountDefinition, "RetVal", "uint64");
+validate(statusCountDefinition);
+
+%% C++ class method |resetStatistics| for C++ class |NITCam| 
+% C++ Signature: void NITCam::resetStatistics()
+
+resetStatisticsDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::resetStatistics()", ...
+    "MATLABName", "resetStatistics", ...
+    "Description", "resetStatistics Method of C++ class NITCam."); % Modify help description values as needed.
+validate(resetStatisticsDefinition);
+
+%% C++ class method |frameStatistics| for C++ class |NITCam| 
+% C++ Signature: FrameStatistics & NITCam::frameStatistics()
+
+%frameStatisticsDefinition = addMethod(NITCamDefinition, ...
+%    "FrameStatistics & NITCam::frameStatistics()", ...
+%    "MATLABName", "frameStatistics", ...
+%    "Description", "frameStatistics Method of C++ class NITCam." + newline + ...
+%    "Direct access for C++ consumers"); % Modify help description values as needed.
+%defineOutput(frameStatisticsDefinition, "RetVal", "clib.NITCam.FrameStatistics", <SHAPE>);
+%validate(frameStatisticsDefinition);
+
+%% C++ class method |setCaptureTimeout| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setCaptureTimeout(int milliseconds)
+
+setCaptureTimeoutDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setCaptureTimeout(int milliseconds)", ...
+    "MATLABName", "setCaptureTimeout", ...
+    "Description", "setCaptureTimeout Method of C++ class NITCam." + newline + ...
+    "Set the capture timeout in milliseconds", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "The timeout is added to the nominal acquisition time (frames / fps), so long captures don't time out."); % Modify help description values as needed.
+defineArgument(setCaptureTimeoutDefinition, "milliseconds", "int32");
+validate(setCaptureTimeoutDefinition);
+
 %% C++ class method |setMgcMinMax| for C++ class |NITCam| 
 % C++ Signature: void NITCam::setMgcMinMax(unsigned short min,unsigned short max)
 
@@ -98,6 +694,130 @@ defineArgument(setMgcMinMaxDefinition, "min", "uint16");
 defineArgument(setMgcMinMaxDefinition, "max", "uint16");
 validate(setMgcMinMaxDefinition);
 
+%% C++ class method |setAgcOptions| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setAgcOptions(int subsample,double smoothing,int refreshInterval,double sceneChange)
+
+setAgcOptionsDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setAgcOptions(int subsample,double smoothing,int refreshInterval,double sceneChange)", ...
+    "MATLABName", "setAgcOptions", ...
+    "Description", "setAgcOptions Method of C++ class NITCam." + newline + ...
+    "setAgcOptions Tune the automatic gain control (bitMode 2)"); % Modify help description values as needed.
+defineArgument(setAgcOptionsDefinition, "subsample", "int32");
+defineArgument(setAgcOptionsDefinition, "smoothing", "double");
+defineArgument(setAgcOptionsDefinition, "refreshInterval", "int32");
+defineArgument(setAgcOptionsDefinition, "sceneChange", "double");
+validate(setAgcOptionsDefinition);
+
+%% C++ class method |setAgcRoi| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setAgcRoi(unsigned short xLeft,unsigned short xRight,unsigned short yTop,unsigned short yBottom)
+
+setAgcRoiDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setAgcRoi(unsigned short xLeft,unsigned short xRight,unsigned short yTop,unsigned short yBottom)", ...
+    "MATLABName", "setAgcRoi", ...
+    "Description", "setAgcRoi Method of C++ class NITCam." + newline + ...
+    "setAgcRoi Build the automatic gain control histogram on a region only, all zeros = full frame"); % Modify help description values as needed.
+defineArgument(setAgcRoiDefinition, "xLeft", "uint16");
+defineArgument(setAgcRoiDefinition, "xRight", "uint16");
+defineArgument(setAgcRoiDefinition, "yTop", "uint16");
+defineArgument(setAgcRoiDefinition, "yBottom", "uint16");
+validate(setAgcRoiDefinition);
+
+%% C++ class method |setAveraging| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setAveraging(int mode,double parameter)
+
+setAveragingDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setAveraging(int mode,double parameter)", ...
+    "MATLABName", "setAveraging", ...
+    "Description", "setAveraging Method of C++ class NITCam." + newline + ...
+    "setAveraging Average frames in the stream, before the gain controls, captures and live view", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "int mode: 0 = off, 1 = running mean since the capture started, 2 = exponential moving average, 3 = blocks of N frames" + newline + ...
+    "double parameter: alpha (0..1] for mode 2, N for mode 3" + newline + ...
+    "In mode 3 the captures ask the camera for N times the requested frames and get one mean per block." + newline + ...
+    "The average restarts with every capture."); % Modify help description values as needed.
+defineArgument(setAveragingDefinition, "mode", "int32");
+defineArgument(setAveragingDefinition, "parameter", "double");
+validate(setAveragingDefinition);
+
+%% C++ class method |setTransform| for C++ class |NITCam| 
+% C++ Signature: void NITCam::setTransform(int mode)
+
+setTransformDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::setTransform(int mode)", ...
+    "MATLABName", "setTransform", ...
+    "Description", "setTransform Method of C++ class NITCam." + newline + ...
+    "setTransform Flip, rotate or transpose the frames in the stream, before the gain controls, captures and live view", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "int mode: 0 = off, 1 = flip horizontal, 2 = flip vertical, 3 = rotate 180, 4 = transpose, 5 = rotate 90 clockwise," + newline + ...
+    "6 = rotate 90 counterclockwise" + newline + ...
+    "Modes 4 to 6 swap capturedRows and capturedColumns. Mode 4 transposes the image itself, in the live view and the files" + newline + ...
+    "too; for column major memory captures of the sensor image use setMemoryFormat(true, ...) instead. Both together" + newline + ...
+    "would transpose twice: mode 4 is refused while column major memory captures are set, and the other way round." + newline + ...
+    "The automatic gain control region is taken in transformed coordinates. NUC and dark frame captures are not transformed."); % Modify help description values as needed.
+defineArgument(setTransformDefinition, "mode", "int32");
+validate(setTransformDefinition);
+
+%% C++ class method |captureDarkFrame| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::captureDarkFrame(bool gatedMode,double triggerDelayInput,double exposureTime,int numOfFrames,bool disableTrigger)
+
+captureDarkFrameDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::captureDarkFrame(bool gatedMode,double triggerDelayInput,double exposureTime,int numOfFrames,bool disableTrigger)", ...
+    "MATLABName", "captureDarkFrame", ...
+    "Description", "captureDarkFrame Method of C++ class NITCam." + newline + ...
+    "captureDarkFrame Capture the dark reference subtracted from the following frames", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "numOfFrames frames are averaged with the given settings, with disableTrigger the trigger input is switched off" + newline + ...
+    "during the capture (no laser pulse) and restored afterwards. The subtraction runs after the NUC and before" + newline + ...
+    "averaging and gain control, values below 0 are clamped. The reference is rounded to whole levels."); % Modify help description values as needed.
+defineArgument(captureDarkFrameDefinition, "gatedMode", "logical");
+defineArgument(captureDarkFrameDefinition, "triggerDelayInput", "double");
+defineArgument(captureDarkFrameDefinition, "exposureTime", "double");
+defineArgument(captureDarkFrameDefinition, "numOfFrames", "int32");
+defineArgument(captureDarkFrameDefinition, "disableTrigger", "logical");
+defineOutput(captureDarkFrameDefinition, "RetVal", "logical");
+validate(captureDarkFrameDefinition);
+
+%% C++ class method |setDarkFrame| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::setDarkFrame(float const * darkFrame,int rows,int columns,int numel)
+
+setDarkFrameDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::setDarkFrame(float const * darkFrame,int rows,int columns,int numel)", ...
+    "MATLABName", "setDarkFrame", ...
+    "Description", "setDarkFrame Method of C++ class NITCam." + newline + ...
+    "setDarkFrame Use a dark reference captured earlier, numel = rows * columns (row major)"); % Modify help description values as needed.
+defineArgument(setDarkFrameDefinition, "darkFrame", "single", "input", "numel");
+defineArgument(setDarkFrameDefinition, "rows", "int32");
+defineArgument(setDarkFrameDefinition, "columns", "int32");
+defineArgument(setDarkFrameDefinition, "numel", "int32");
+defineOutput(setDarkFrameDefinition, "RetVal", "logical");
+validate(setDarkFrameDefinition);
+
+%% C++ class method |darkFrame| for C++ class |NITCam| 
+% C++ Signature: float const * NITCam::darkFrame(size_t numel)
+
+darkFrameDefinition = addMethod(NITCamDefinition, ...
+    "float const * NITCam::darkFrame(size_t numel)", ...
+    "MATLABName", "darkFrame", ...
+    "Description", "darkFrame Method of C++ class NITCam." + newline + ...
+    "darkFrame Current dark reference, NULL if numel doesn't match"); % Modify help description values as needed.
+defineArgument(darkFrameDefinition, "numel", "uint64");
+defineOutput(darkFrameDefinition, "RetVal", "single", "numel");
+validate(darkFrameDefinition);
+
+%% C++ class method |activateDarkFrame| for C++ class |NITCam| 
+% C++ Signature: void NITCam::activateDarkFrame(bool state)
+
+activateDarkFrameDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::activateDarkFrame(bool state)", ...
+    "MATLABName", "activateDarkFrame", ...
+    "Description", "activateDarkFrame Method of C++ class NITCam." + newline + ...
+    "activateDarkFrame Switch the dark frame subtraction on and off, the reference is kept"); % Modify help description values as needed.
+defineArgument(activateDarkFrameDefinition, "state", "logical");
+validate(activateDarkFrameDefinition);
+
 %% C++ class method |startLiveImage| for C++ class |NITCam| 
 % C++ Signature: void NITCam::startLiveImage()
 
@@ -131,10 +851,31 @@ validate(stopLiveImageDefinition);
 setNucDirectoryDefinition = addMethod(NITCamDefinition, ...
     "void NITCam::setNucDirectory(std::string const nucFileDirectory)", ...
     "MATLABName", "setNucDirectory", ...
-    "Description", "setNucDirectory Method of C++ class NITCam."); % Modify help description values as needed.
+    "Description", "setNucDirectory Method of C++ class NITCam." + newline + ...
+    "setNucDirectory Hand the directory of the NUC files to the SDK", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "With the software NUC on, the SDK applies it to the exposures without a table."); % Modify help description values as needed.
 defineArgument(setNucDirectoryDefinition, "nucFileDirectory", "string");
 validate(setNucDirectoryDefinition);
 
+%% C++ class method |loadNucTables| for C++ class |NITCam| 
+% C++ Signature: int NITCam::loadNucTables(std::string const tableDirectory)
+
+loadNucTablesDefinition = addMethod(NITCamDefinition, ...
+    "int NITCam::loadNucTables(std::string const tableDirectory)", ...
+    "MATLABName", "loadNucTables", ...
+    "Description", "loadNucTables Method of C++ class NITCam." + newline + ...
+    "loadNucTables Preload the NUC tables written by writeNucCalibration", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Every .yml table of the directory (or of its NUC subdirectory) is read once and kept in memory, indexed by exposure" + newline + ...
+    "time and gated/global shutter mode, and added to the tables already loaded. The directory is not handed to the SDK." + newline + ...
+    "The tables are only used once useSoftwareNuc(true) is called. Returns the number of tables loaded."); % Modify help description values as needed.
+defineArgument(loadNucTablesDefinition, "tableDirectory", "string");
+defineOutput(loadNucTablesDefinition, "RetVal", "int32");
+validate(loadNucTablesDefinition);
+
 %% C++ class method |setNucFile| for C++ class |NITCam| 
 % C++ Signature: void NITCam::setNucFile(std::string const nucFileDirectory)
 
@@ -203,6 +944,109 @@ bprActiveDefinition = addMethod(NITCamDefinition, ...
     "Description", "bprActive Method of C++ class NITCam."); % Modify help description values as needed.
 validate(bprActiveDefinition);
 
+%% C++ class method |useSoftwareNuc| for C++ class |NITCam| 
+% C++ Signature: void NITCam::useSoftwareNuc(bool state)
+
+useSoftwareNucDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::useSoftwareNuc(bool state)", ...
+    "MATLABName", "useSoftwareNuc", ...
+    "Description", "useSoftwareNuc Method of C++ class NITCam." + newline + ...
+    "useSoftwareNuc Correct the frames in software instead of the device", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "The device NUC and BPR are switched off and each capture uses the table added with addNucTable or loadNucTables for" + newline + ...
+    "its exposure time. Exposures without a table get the SDK NUC of the setNucDirectory directory, if any, else they" + newline + ...
+    "are not corrected."); % Modify help description values as needed.
+defineArgument(useSoftwareNucDefinition, "state", "logical");
+validate(useSoftwareNucDefinition);
+
+%% C++ class method |addNucTable| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::addNucTable(double exposureTime,int rows,int columns,float const * gain,float const * offset,unsigned char const * badPixels,int numel)
+
+addNucTableDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::addNucTable(double exposureTime,int rows,int columns,float const * gain,float const * offset,unsigned char const * badPixels,int numel)", ...
+    "MATLABName", "addNucTable", ...
+    "Description", "addNucTable Method of C++ class NITCam." + newline + ...
+    "addNucTable Add the software NUC table of one exposure time", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "gain, offset and badPixels hold rows x columns values (row major), numel = rows * columns." + newline + ...
+    "corrected = raw * gain + offset, pixels with a non zero badPixels value are replaced by the mean of their good neighbours."); % Modify help description values as needed.
+defineArgument(addNucTableDefinition, "exposureTime", "double");
+defineArgument(addNucTableDefinition, "rows", "int32");
+defineArgument(addNucTableDefinition, "columns", "int32");
+defineArgument(addNucTableDefinition, "gain", "single", "input", "numel");
+defineArgument(addNucTableDefinition, "offset", "single", "input", "numel");
+defineArgument(addNucTableDefinition, "badPixels", "uint8", "input", "numel");
+defineArgument(addNucTableDefinition, "numel", "int32");
+defineOutput(addNucTableDefinition, "RetVal", "logical");
+validate(addNucTableDefinition);
+
+%% C++ class method |clearNucTables| for C++ class |NITCam| 
+% C++ Signature: void NITCam::clearNucTables()
+
+clearNucTablesDefinition = addMethod(NITCamDefinition, ...
+    "void NITCam::clearNucTables()", ...
+    "MATLABName", "clearNucTables", ...
+    "Description", "clearNucTables Method of C++ class NITCam."); % Modify help description values as needed.
+validate(clearNucTablesDefinition);
+
+%% C++ class method |captureNucLowPoints| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::captureNucLowPoints(bool gatedMode,double triggerDelayInput,double const * exposureTimes,int numExposures,int framesPerPoint,double rejectSigma)
+
+captureNucLowPointsDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::captureNucLowPoints(bool gatedMode,double triggerDelayInput,double const * exposureTimes,int numExposures,int framesPerPoint,double rejectSigma)", ...
+    "MATLABName", "captureNucLowPoints", ...
+    "Description", "captureNucLowPoints Method of C++ class NITCam." + newline + ...
+    "captureNucLowPoints Capture the low flat field of each exposure time for the NUC calibration", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Point the camera at a uniform dark (or cold) scene first. For each exposure time framesPerPoint raw frames are" + newline + ...
+    "averaged per pixel without storing them; samples further than rejectSigma standard deviations from the running mean" + newline + ...
+    "of their pixel are left out (0 keeps every sample). NUC and gain controls are off during the capture."); % Modify help description values as needed.
+defineArgument(captureNucLowPointsDefinition, "gatedMode", "logical");
+defineArgument(captureNucLowPointsDefinition, "triggerDelayInput", "double");
+defineArgument(captureNucLowPointsDefinition, "exposureTimes", "double", "input", "numExposures");
+defineArgument(captureNucLowPointsDefinition, "numExposures", "int32");
+defineArgument(captureNucLowPointsDefinition, "framesPerPoint", "int32");
+defineArgument(captureNucLowPointsDefinition, "rejectSigma", "double");
+defineOutput(captureNucLowPointsDefinition, "RetVal", "logical");
+validate(captureNucLowPointsDefinition);
+
+%% C++ class method |captureNucHighPoints| for C++ class |NITCam| 
+% C++ Signature: bool NITCam::captureNucHighPoints(bool gatedMode,double triggerDelayInput,double const * exposureTimes,int numExposures,int framesPerPoint,double rejectSigma)
+
+captureNucHighPointsDefinition = addMethod(NITCamDefinition, ...
+    "bool NITCam::captureNucHighPoints(bool gatedMode,double triggerDelayInput,double const * exposureTimes,int numExposures,int framesPerPoint,double rejectSigma)", ...
+    "MATLABName", "captureNucHighPoints", ...
+    "Description", "captureNucHighPoints Method of C++ class NITCam." + newline + ...
+    "captureNucHighPoints Capture the high flat field of each exposure time, same as captureNucLowPoints with a uniform bright scene"); % Modify help description values as needed.
+defineArgument(captureNucHighPointsDefinition, "gatedMode", "logical");
+defineArgument(captureNucHighPointsDefinition, "triggerDelayInput", "double");
+defineArgument(captureNucHighPointsDefinition, "exposureTimes", "double", "input", "numExposures");
+defineArgument(captureNucHighPointsDefinition, "numExposures", "int32");
+defineArgument(captureNucHighPointsDefinition, "framesPerPoint", "int32");
+defineArgument(captureNucHighPointsDefinition, "rejectSigma", "double");
+defineOutput(captureNucHighPointsDefinition, "RetVal", "logical");
+validate(captureNucHighPointsDefinition);
+
+%% C++ class method |writeNucCalibration| for C++ class |NITCam| 
+% C++ Signature: int NITCam::writeNucCalibration(std::string const directory)
+
+writeNucCalibrationDefinition = addMethod(NITCamDefinition, ...
+    "int NITCam::writeNucCalibration(std::string const directory)", ...
+    "MATLABName", "writeNucCalibration", ...
+    "Description", "writeNucCalibration Method of C++ class NITCam." + newline + ...
+    "writeNucCalibration Compute the NUC of every exposure time with a low and a high point", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "One NUCFactory_<mode>_<exposure>us.yml per exposure is written into directory, then the directory is loaded" + newline + ...
+    "with loadNucTables; call useSoftwareNuc(true) to correct the frames with it. The files are not in the SDK format:" + newline + ...
+    "use a directory of their own and never give it to setNucDirectory. Returns the number of files written."); % Modify help description values as needed.
+defineArgument(writeNucCalibrationDefinition, "directory", "string");
+defineOutput(writeNucCalibrationDefinition, "RetVal", "int32");
+validate(writeNucCalibrationDefinition);
+
 %% C++ class public data member |config_observer| for C++ class |NITCam| 
 % C++ Signature: UsbConfigObserver NITCam::config_observer
 
@@ -210,10 +1054,10 @@ addProperty(NITCamDefinition, "config_observer", "clib.NITCam.UsbConfigObserver"
     "Description", "clib.NITCam.UsbConfigObserver    Data member of C++ class NITCam."); % Modify help description values as needed.
 
 %% C++ class public data member |dev| for C++ class |NITCam| 
-% C++ Signature: NITLibrary::NITDevice * NITCam::dev
+% C++ Signature: CameraDevice * NITCam::dev
 
-%addProperty(NITCamDefinition, "dev", "clib.NITCam.NITLibrary.NITDevice", <SHAPE>, ... % <MLTYPE> can be "clib.NITCam.NITLibrary.NITDevice", or "clib.array.NITCam.NITLibrary.NITDevice"
-%    "Description", "clib.NITCam.NITLibrary.NITDevice    Data member of C++ class NITCam."); % Modify help description values as needed.
+%addProperty(NITCamDefinition, "dev", "clib.NITCam.CameraDevice", <SHAPE>, ... % <MLTYPE> can be "clib.NITCam.CameraDevice", or "clib.array.NITCam.CameraDevice"
+%    "Description", "clib.NITCam.CameraDevice    Data member of C++ class NITCam."); % Modify help description values as needed.
 
 %% C++ class public data member |directory| for C++ class |NITCam| 
 % C++ Signature: std::string NITCam::directory
@@ -222,23 +1066,23 @@ addProperty(NITCamDefinition, "directory", "string", ...
     "Description", "string    Data member of C++ class NITCam."); % Modify help description values as needed.
 
 %% C++ function |ConfigureDevice| with MATLAB name |clib.NITCam.ConfigureDevice|
-% C++ Signature: void ConfigureDevice(NITLibrary::NITDevice * dev)
+% C++ Signature: void ConfigureDevice(CameraDevice * dev)
 
 %ConfigureDeviceDefinition = addFunction(libDef, ...
-%    "void ConfigureDevice(NITLibrary::NITDevice * dev)", ...
+%    "void ConfigureDevice(CameraDevice * dev)", ...
 %    "MATLABName", "clib.NITCam.ConfigureDevice", ...
 %    "Description", "clib.NITCam.ConfigureDevice Representation of C++ function ConfigureDevice."); % Modify help description values as needed.
-%defineArgument(ConfigureDeviceDefinition, "dev", "clib.NITCam.NITLibrary.NITDevice", "input", <SHAPE>); % <MLTYPE> can be "clib.NITCam.NITLibrary.NITDevice", or "clib.array.NITCam.NITLibrary.NITDevice"
+%defineArgument(ConfigureDeviceDefinition, "dev", "clib.NITCam.CameraDevice", "input", <SHAPE>); % <MLTYPE> can be "clib.NITCam.CameraDevice", or "clib.array.NITCam.CameraDevice"
 %validate(ConfigureDeviceDefinition);
 
 %% C++ function |CreateDevice| with MATLAB name |clib.NITCam.CreateDevice|
-% C++ Signature: NITLibrary::NITDevice * CreateDevice()
+% C++ Signature: CameraDevice * CreateDevice()
 
 %CreateDeviceDefinition = addFunction(libDef, ...
-%    "NITLibrary::NITDevice * CreateDevice()", ...
+%    "CameraDevice * CreateDevice()", ...
 %    "MATLABName", "clib.NITCam.CreateDevice", ...
 %    "Description", "clib.NITCam.CreateDevice Representation of C++ function CreateDevice."); % Modify help description values as needed.
-%defineOutput(CreateDeviceDefinition, "RetVal", "clib.NITCam.NITLibrary.NITDevice", <SHAPE>);
+%defineOutput(CreateDeviceDefinition, "RetVal", "clib.NITCam.CameraDevice", <SHAPE>);
 %validate(CreateDeviceDefinition);
 
 %% C++ enumeration |NITLibrary::ConnectorType| with MATLAB name |clib.NITCam.NITLibrary.ConnectorType| 
@@ -263,6 +1107,425 @@ addEnumeration(libDef, "NITLibrary::ConnectorType", "int32",...
       "",...  % CL_IMPERX
     ]); % Modify help description values as needed.
 
+%% C++ class |SequenceReader| with MATLAB name |clib.NITCam.SequenceReader| 
+SequenceReaderDefinition = addClass(libDef, "SequenceReader", "MATLABName", "clib.NITCam.SequenceReader", ...
+    "Description", "clib.NITCam.SequenceReader    Representation of C++ class SequenceReader." + newline + ...
+    "Random access to a sequence file written by captureFrames with fileType seq"); % Modify help description values as needed.
+
+%% C++ class constructor for C++ class |SequenceReader| 
+% C++ Signature: SequenceReader::SequenceReader()
+
+SequenceReaderConstructor1Definition = addConstructor(SequenceReaderDefinition, ...
+    "SequenceReader::SequenceReader()", ...
+    "Description", "clib.NITCam.SequenceReader Constructor of C++ class SequenceReader."); % Modify help description values as needed.
+validate(SequenceReaderConstructor1Definition);
+
+%% C++ class method |open| for C++ class |SequenceReader| 
+% C++ Signature: bool SequenceReader::open(std::string const & fileName)
+
+openDefinition = addMethod(SequenceReaderDefinition, ...
+    "bool SequenceReader::open(std::string const & fileName)", ...
+    "MATLABName", "open", ...
+    "Description", "open Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineArgument(openDefinition, "fileName", "string", "input");
+defineOutput(openDefinition, "RetVal", "logical");
+validate(openDefinition);
+
+%% C++ class method |close| for C++ class |SequenceReader| 
+% C++ Signature: void SequenceReader::close()
+
+closeDefinition = addMethod(SequenceReaderDefinition, ...
+    "void SequenceReader::close()", ...
+    "MATLABName", "close", ...
+    "Description", "close Method of C++ class SequenceReader."); % Modify help description values as needed.
+validate(closeDefinition);
+
+%% C++ class method |isOpen| for C++ class |SequenceReader| 
+% C++ Signature: bool SequenceReader::isOpen() const
+
+isOpenDefinition = addMethod(SequenceReaderDefinition, ...
+    "bool SequenceReader::isOpen() const", ...
+    "MATLABName", "isOpen", ...
+    "Description", "isOpen Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineOutput(isOpenDefinition, "RetVal", "logical");
+validate(isOpenDefinition);
+
+%% C++ class method |width| for C++ class |SequenceReader| 
+% C++ Signature: unsigned int SequenceReader::width() const
+
+widthDefinition = addMethod(SequenceReaderDefinition, ...
+    "unsigned int SequenceReader::width() const", ...
+    "MATLABName", "width", ...
+    "Description", "width Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineOutput(widthDefinition, "RetVal", "uint32");
+validate(widthDefinition);
+
+%% C++ class method |height| for C++ class |SequenceReader| 
+% C++ Signature: unsigned int SequenceReader::height() const
+
+heightDefinition = addMethod(SequenceReaderDefinition, ...
+    "unsigned int SequenceReader::height() const", ...
+    "MATLABName", "height", ...
+    "Description", "height Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineOutput(heightDefinition, "RetVal", "uint32");
+validate(heightDefinition);
+
+%% C++ class method |bitDepth| for C++ class |SequenceReader| 
+% C++ Signature: unsigned int SequenceReader::bitDepth() const
+
+bitDepthDefinition = addMethod(SequenceReaderDefinition, ...
+    "unsigned int SequenceReader::bitDepth() const", ...
+    "MATLABName", "bitDepth", ...
+    "Description", "bitDepth Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineOutput(bitDepthDefinition, "RetVal", "uint32");
+validate(bitDepthDefinition);
+
+%% C++ class method |frameCount| for C++ class |SequenceReader| 
+% C++ Signature: unsigned long long SequenceReader::frameCount() const
+
+frameCountDefinition = addMethod(SequenceReaderDefinition, ...
+    "unsigned long long SequenceReader::frameCount() const", ...
+    "MATLABName", "frameCount", ...
+    "Description", "frameCount Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineOutput(frameCountDefinition, "RetVal", "uint64");
+validate(frameCountDefinition);
+
+%% C++ class method |frame16| for C++ class |SequenceReader| 
+% C++ Signature: unsigned short const * SequenceReader::frame16(unsigned long long frame, size_t numel) const
+
+frame16Definition = addMethod(SequenceReaderDefinition, ...
+    "unsigned short const * SequenceReader::frame16(unsigned long long frame, size_t numel) const", ...
+    "MATLABName", "frame16", ...
+    "Description", "frame16 Method of C++ class SequenceReader." + newline + ...
+    "View of one frame, numel must be height() * width()"); % Modify help description values as needed.
+defineArgument(frame16Definition, "frame", "uint64");
+defineArgument(frame16Definition, "numel", "uint64");
+defineOutput(frame16Definition, "RetVal", "uint16", "numel");
+validate(frame16Definition);
+
+%% C++ class method |frames16| for C++ class |SequenceReader| 
+% C++ Signature: unsigned short const * SequenceReader::frames16(unsigned long long first, unsigned long long count, size_t numel) const
+
+frames16Definition = addMethod(SequenceReaderDefinition, ...
+    "unsigned short const * SequenceReader::frames16(unsigned long long first, unsigned long long count, size_t numel) const", ...
+    "MATLABName", "frames16", ...
+    "Description", "frames16 Method of C++ class SequenceReader." + newline + ...
+    "View of count consecutive frames, numel must be count * height() * width()"); % Modify help description values as needed.
+defineArgument(frames16Definition, "first", "uint64");
+defineArgument(frames16Definition, "count", "uint64");
+defineArgument(frames16Definition, "numel", "uint64");
+defineOutput(frames16Definition, "RetVal", "uint16", "numel");
+validate(frames16Definition);
+
+%% C++ class method |frame8| for C++ class |SequenceReader| 
+% C++ Signature: unsigned char const * SequenceReader::frame8(unsigned long long frame, size_t numel) const
+
+frame8Definition = addMethod(SequenceReaderDefinition, ...
+    "unsigned char const * SequenceReader::frame8(unsigned long long frame, size_t numel) const", ...
+    "MATLABName", "frame8", ...
+    "Description", "frame8 Method of C++ class SequenceReader." + newline + ...
+    "View of one frame, numel must be height() * width()"); % Modify help description values as needed.
+defineArgument(frame8Definition, "frame", "uint64");
+defineArgument(frame8Definition, "numel", "uint64");
+defineOutput(frame8Definition, "RetVal", "uint8", "numel");
+validate(frame8Definition);
+
+%% C++ class method |frames8| for C++ class |SequenceReader| 
+% C++ Signature: unsigned char const * SequenceReader::frames8(unsigned long long first, unsigned long long count, size_t numel) const
+
+frames8Definition = addMethod(SequenceReaderDefinition, ...
+    "unsigned char const * SequenceReader::frames8(unsigned long long first, unsigned long long count, size_t numel) const", ...
+    "MATLABName", "frames8", ...
+    "Description", "frames8 Method of C++ class SequenceReader." + newline + ...
+    "View of count consecutive frames, numel must be count * height() * width()"); % Modify help description values as needed.
+defineArgument(frames8Definition, "first", "uint64");
+defineArgument(frames8Definition, "count", "uint64");
+defineArgument(frames8Definition, "numel", "uint64");
+defineOutput(frames8Definition, "RetVal", "uint8", "numel");
+validate(frames8Definition);
+
+%% C++ class method |readFrames16| for C++ class |SequenceReader| 
+% C++ Signature: bool SequenceReader::readFrames16(unsigned long long first, unsigned long long count, unsigned long long stride, unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns, unsigned short * data, size_t numel) const
+
+readFrames16Definition = addMethod(SequenceReaderDefinition, ...
+    "bool SequenceReader::readFrames16(unsigned long long first, unsigned long long count, unsigned long long stride, unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns, unsigned short * data, size_t numel) const", ...
+    "MATLABName", "readFrames16", ...
+    "Description", "readFrames16 Method of C++ class SequenceReader." + newline + ...
+    "Copy frames first, first + stride, ... (count frames) cropped to the ROI into data"); % Modify help description values as needed.
+defineArgument(readFrames16Definition, "first", "uint64");
+defineArgument(readFrames16Definition, "count", "uint64");
+defineArgument(readFrames16Definition, "stride", "uint64");
+defineArgument(readFrames16Definition, "roiRow", "uint32");
+defineArgument(readFrames16Definition, "roiColumn", "uint32");
+defineArgument(readFrames16Definition, "roiRows", "uint32");
+defineArgument(readFrames16Definition, "roiColumns", "uint32");
+defineArgument(readFrames16Definition, "data", "uint16", "output", "numel");
+defineArgument(readFrames16Definition, "numel", "uint64");
+defineOutput(readFrames16Definition, "RetVal", "logical");
+validate(readFrames16Definition);
+
+%% C++ class method |readFrames8| for C++ class |SequenceReader| 
+% C++ Signature: bool SequenceReader::readFrames8(unsigned long long first, unsigned long long count, unsigned long long stride, unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns, unsigned char * data, size_t numel) const
+
+readFrames8Definition = addMethod(SequenceReaderDefinition, ...
+    "bool SequenceReader::readFrames8(unsigned long long first, unsigned long long count, unsigned long long stride, unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns, unsigned char * data, size_t numel) const", ...
+    "MATLABName", "readFrames8", ...
+    "Description", "readFrames8 Method of C++ class SequenceReader." + newline + ...
+    "Copy frames first, first + stride, ... (count frames) cropped to the ROI into data"); % Modify help description values as needed.
+defineArgument(readFrames8Definition, "first", "uint64");
+defineArgument(readFrames8Definition, "count", "uint64");
+defineArgument(readFrames8Definition, "stride", "uint64");
+defineArgument(readFrames8Definition, "roiRow", "uint32");
+defineArgument(readFrames8Definition, "roiColumn", "uint32");
+defineArgument(readFrames8Definition, "roiRows", "uint32");
+defineArgument(readFrames8Definition, "roiColumns", "uint32");
+defineArgument(readFrames8Definition, "data", "uint8", "output", "numel");
+defineArgument(readFrames8Definition, "numel", "uint64");
+defineOutput(readFrames8Definition, "RetVal", "logical");
+validate(readFrames8Definition);
+
+%% C++ class method |frameId| for C++ class |SequenceReader| 
+% C++ Signature: unsigned long long SequenceReader::frameId(unsigned long long frame) const
+
+frameIdDefinition = addMethod(SequenceReaderDefinition, ...
+    "unsigned long long SequenceReader::frameId(unsigned long long frame) const", ...
+    "MATLABName", "frameId", ...
+    "Description", "frameId Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineArgument(frameIdDefinition, "frame", "uint64");
+defineOutput(frameIdDefinition, "RetVal", "uint64");
+validate(frameIdDefinition);
+
+%% C++ class method |frameTemperature| for C++ class |SequenceReader| 
+% C++ Signature: float SequenceReader::frameTemperature(unsigned long long frame) const
+
+frameTemperatureDefinition = addMethod(SequenceReaderDefinition, ...
+    "float SequenceReader::frameTemperature(unsigned long long frame) const", ...
+    "MATLABName", "frameTemperature", ...
+    "Description", "frameTemperature Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineArgument(frameTemperatureDefinition, "frame", "uint64");
+defineOutput(frameTemperatureDefinition, "RetVal", "single");
+validate(frameTemperatureDefinition);
+
+%% C++ class method |frameTimestamp| for C++ class |SequenceReader| 
+% C++ Signature: double SequenceReader::frameTimestamp(unsigned long long frame) const
+
+frameTimestampDefinition = addMethod(SequenceReaderDefinition, ...
+    "double SequenceReader::frameTimestamp(unsigned long long frame) const", ...
+    "MATLABName", "frameTimestamp", ...
+    "Description", "frameTimestamp Method of C++ class SequenceReader."); % Modify help description values as needed.
+defineArgument(frameTimestampDefinition, "frame", "uint64");
+defineOutput(frameTimestampDefinition, "RetVal", "double");
+validate(frameTimestampDefinition);
+
+%% C++ class |NITCamArray| with MATLAB name |clib.NITCam.NITCamArray| 
+NITCamArrayDefinition = addClass(libDef, "NITCamArray", "MATLABName", "clib.NITCam.NITCamArray", ...
+    "Description", "clib.NITCam.NITCamArray    Representation of C++ class NITCamArray." + newline + ...
+    "Several NIT cameras triggered together", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "The cameras are opened by serial number and configured and armed concurrently, one thread per camera, so the" + newline + ...
+    "setup time doesn't grow with the number of cameras. Armed cameras wait for the external trigger and stream into" + newline + ...
+    "their own frame ring (see NITCam::startFrameRing). nextAlignedFrames pairs the ring fronts by frame Id: the Id of" + newline + ...
+    "the first frame after arm is the origin of each camera, frames one camera got and another one missed are dropped."); % Modify help description values as needed.
+
+%% C++ class constructor for C++ class |NITCamArray| 
+% C++ Signature: NITCamArray::NITCamArray()
+
+NITCamArrayConstructor1Definition = addConstructor(NITCamArrayDefinition, ...
+    "NITCamArray::NITCamArray()", ...
+    "Description", "clib.NITCam.NITCamArray Constructor of C++ class NITCamArray."); % Modify help description values as needed.
+validate(NITCamArrayConstructor1Definition);
+
+%% C++ class method |open| for C++ class |NITCamArray| 
+% C++ Signature: int NITCamArray::open(std::string const serialNumbers)
+
+NITCamArrayOpenDefinition = addMethod(NITCamArrayDefinition, ...
+    "int NITCamArray::open(std::string const serialNumbers)", ...
+    "MATLABName", "open", ...
+    "Description", "open Method of C++ class NITCamArray." + newline + ...
+    "Open the cameras of a comma separated list of serial numbers, all discovered cameras if empty", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "The cameras already open are closed first. Returns the number of cameras opened, cameras that can't be" + newline + ...
+    "opened are reported and left out."); % Modify help description values as needed.
+defineArgument(NITCamArrayOpenDefinition, "serialNumbers", "string");
+defineOutput(NITCamArrayOpenDefinition, "RetVal", "int32");
+validate(NITCamArrayOpenDefinition);
+
+%% C++ class method |close| for C++ class |NITCamArray| 
+% C++ Signature: void NITCamArray::close()
+
+NITCamArrayCloseDefinition = addMethod(NITCamArrayDefinition, ...
+    "void NITCamArray::close()", ...
+    "MATLABName", "close", ...
+    "Description", "close Method of C++ class NITCamArray."); % Modify help description values as needed.
+validate(NITCamArrayCloseDefinition);
+
+%% C++ class method |cameraCount| for C++ class |NITCamArray| 
+% C++ Signature: unsigned int NITCamArray::cameraCount()
+
+cameraCountDefinition = addMethod(NITCamArrayDefinition, ...
+    "unsigned int NITCamArray::cameraCount()", ...
+    "MATLABName", "cameraCount", ...
+    "Description", "cameraCount Method of C++ class NITCamArray."); % Modify help description values as needed.
+defineOutput(cameraCountDefinition, "RetVal", "uint32");
+validate(cameraCountDefinition);
+
+%% C++ class method |serialNumber| for C++ class |NITCamArray| 
+% C++ Signature: std::string NITCamArray::serialNumber(unsigned int index)
+
+NITCamArraySerialNumberDefinition = addMethod(NITCamArrayDefinition, ...
+    "std::string NITCamArray::serialNumber(unsigned int index)", ...
+    "MATLABName", "serialNumber", ...
+    "Description", "serialNumber Method of C++ class NITCamArray."); % Modify help description values as needed.
+defineArgument(NITCamArraySerialNumberDefinition, "index", "uint32");
+defineOutput(NITCamArraySerialNumberDefinition, "RetVal", "string");
+validate(NITCamArraySerialNumberDefinition);
+
+%% C++ class method |camera| for C++ class |NITCamArray| 
+% C++ Signature: NITCam & NITCamArray::camera(unsigned int index)
+
+cameraDefinition = addMethod(NITCamArrayDefinition, ...
+    "NITCam & NITCamArray::camera(unsigned int index)", ...
+    "MATLABName", "camera", ...
+    "Description", "camera Method of C++ class NITCamArray." + newline + ...
+    "Direct access to one camera, for the settings not covered by the array"); % Modify help description values as needed.
+defineArgument(cameraDefinition, "index", "uint32");
+defineOutput(cameraDefinition, "RetVal", "clib.NITCam.NITCam");
+validate(cameraDefinition);
+
+%% C++ class method |configure| for C++ class |NITCamArray| 
+% C++ Signature: bool NITCamArray::configure(bool gatedMode,double triggerDelayInput,double exposureTime)
+
+NITCamArrayConfigureDefinition = addMethod(NITCamArrayDefinition, ...
+    "bool NITCamArray::configure(bool gatedMode,double triggerDelayInput,double exposureTime)", ...
+    "MATLABName", "configure", ...
+    "Description", "configure Method of C++ class NITCamArray." + newline + ...
+    "Set mode, trigger delay and exposure time of every camera, true if all of them succeeded"); % Modify help description values as needed.
+defineArgument(NITCamArrayConfigureDefinition, "gatedMode", "logical");
+defineArgument(NITCamArrayConfigureDefinition, "triggerDelayInput", "double");
+defineArgument(NITCamArrayConfigureDefinition, "exposureTime", "double");
+defineOutput(NITCamArrayConfigureDefinition, "RetVal", "logical");
+validate(NITCamArrayConfigureDefinition);
+
+%% C++ class method |arm| for C++ class |NITCamArray| 
+% C++ Signature: bool NITCamArray::arm(unsigned int slotCount,int bitMode)
+
+armDefinition = addMethod(NITCamArrayDefinition, ...
+    "bool NITCamArray::arm(unsigned int slotCount,int bitMode)", ...
+    "MATLABName", "arm", ...
+    "Description", "arm Method of C++ class NITCamArray." + newline + ...
+    "Switch every camera to trigger input and stream into rings of slotCount frames", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "int bitMode: 0 = 14-bit, 1 = 8-bit manual gain control, 2 = 8-bit automatic gain control" + newline + ...
+    "Start the trigger after arm returned true."); % Modify help description values as needed.
+defineArgument(armDefinition, "slotCount", "uint32");
+defineArgument(armDefinition, "bitMode", "int32");
+defineOutput(armDefinition, "RetVal", "logical");
+validate(armDefinition);
+
+%% C++ class method |disarm| for C++ class |NITCamArray| 
+% C++ Signature: void NITCamArray::disarm()
+
+disarmDefinition = addMethod(NITCamArrayDefinition, ...
+    "void NITCamArray::disarm()", ...
+    "MATLABName", "disarm", ...
+    "Description", "disarm Method of C++ class NITCamArray." + newline + ...
+    "Stop streaming, the queued frames stay readable"); % Modify help description values as needed.
+validate(disarmDefinition);
+
+%% C++ class method |nextAlignedFrames| for C++ class |NITCamArray| 
+% C++ Signature: bool NITCamArray::nextAlignedFrames()
+
+nextAlignedFramesDefinition = addMethod(NITCamArrayDefinition, ...
+    "bool NITCamArray::nextAlignedFrames()", ...
+    "MATLABName", "nextAlignedFrames", ...
+    "Description", "nextAlignedFrames Method of C++ class NITCamArray." + newline + ...
+    "Drop unmatched frames until every ring front holds the same frame, false if a ring runs empty", ...
+    "DetailedDescription", "This content is from the external library documentation." + newline + ...
+    "" + newline + ...
+    "Read the aligned frames with alignedFrameData16 / alignedFrameData8 and hand them back with releaseAlignedFrames."); % Modify help description values as needed.
+defineOutput(nextAlignedFramesDefinition, "RetVal", "logical");
+validate(nextAlignedFramesDefinition);
+
+%% C++ class method |alignedFrameId| for C++ class |NITCamArray| 
+% C++ Signature: unsigned long long NITCamArray::alignedFrameId()
+
+alignedFrameIdDefinition = addMethod(NITCamArrayDefinition, ...
+    "unsigned long long NITCamArray::alignedFrameId()", ...
+    "MATLABName", "alignedFrameId", ...
+    "Description", "alignedFrameId Method of C++ class NITCamArray." + newline + ...
+    "Frame Id of the aligned frames, counted from 0 at arm"); % Modify help description values as needed.
+defineOutput(alignedFrameIdDefinition, "RetVal", "uint64");
+validate(alignedFrameIdDefinition);
+
+%% C++ class method |alignedFrameData16| for C++ class |NITCamArray| 
+% C++ Signature: unsigned short const * NITCamArray::alignedFrameData16(unsigned int index,size_t numel)
+
+alignedFrameData16Definition = addMethod(NITCamArrayDefinition, ...
+    "unsigned short const * NITCamArray::alignedFrameData16(unsigned int index,size_t numel)", ...
+    "MATLABName", "alignedFrameData16", ...
+    "Description", "alignedFrameData16 Method of C++ class NITCamArray."); % Modify help description values as needed.
+defineArgument(alignedFrameData16Definition, "index", "uint32");
+defineArgument(alignedFrameData16Definition, "numel", "uint64");
+defineOutput(alignedFrameData16Definition, "RetVal", "uint16", "numel");
+validate(alignedFrameData16Definition);
+
+%% C++ class method |alignedFrameData8| for C++ class |NITCamArray| 
+% C++ Signature: unsigned char const * NITCamArray::alignedFrameData8(unsigned int index,size_t numel)
+
+alignedFrameData8Definition = addMethod(NITCamArrayDefinition, ...
+    "unsigned char const * NITCamArray::alignedFrameData8(unsigned int index,size_t numel)", ...
+    "MATLABName", "alignedFrameData8", ...
+    "Description", "alignedFrameData8 Method of C++ class NITCamArray."); % Modify help description values as needed.
+defineArgument(alignedFrameData8Definition, "index", "uint32");
+defineArgument(alignedFrameData8Definition, "numel", "uint64");
+defineOutput(alignedFrameData8Definition, "RetVal", "uint8", "numel");
+validate(alignedFrameData8Definition);
+
+%% C++ class method |releaseAlignedFrames| for C++ class |NITCamArray| 
+% C++ Signature: void NITCamArray::releaseAlignedFrames()
+
+releaseAlignedFramesDefinition = addMethod(NITCamArrayDefinition, ...
+    "void NITCamArray::releaseAlignedFrames()", ...
+    "MATLABName", "releaseAlignedFrames", ...
+    "Description", "releaseAlignedFrames Method of C++ class NITCamArray."); % Modify help description values as needed.
+validate(releaseAlignedFramesDefinition);
+
+%% C++ class method |unalignedFrames| for C++ class |NITCamArray| 
+% C++ Signature: unsigned long long NITCamArray::unalignedFrames()
+
+unalignedFramesDefinition = addMethod(NITCamArrayDefinition, ...
+    "unsigned long long NITCamArray::unalignedFrames()", ...
+    "MATLABName", "unalignedFrames", ...
+    "Description", "unalignedFrames Method of C++ class NITCamArray." + newline + ...
+    "Frames dropped by nextAlignedFrames since arm because a camera missed them"); % Modify help description values as needed.
+defineOutput(unalignedFramesDefinition, "RetVal", "uint64");
+validate(unalignedFramesDefinition);
+
+%% C++ class method |reanchors| for C++ class |NITCamArray| 
+% C++ Signature: unsigned long long NITCamArray::reanchors()
+
+reanchorsDefinition = addMethod(NITCamArrayDefinition, ...
+    "unsigned long long NITCamArray::reanchors()", ...
+    "MATLABName", "reanchors", ...
+    "Description", "reanchors Method of C++ class NITCamArray." + newline + ...
+    "How often since arm the Id alignment disagreed with the arrival times and was taken again"); % Modify help description values as needed.
+defineOutput(reanchorsDefinition, "RetVal", "uint64");
+validate(reanchorsDefinition);
+
+%% C++ class method |ringOverflows| for C++ class |NITCamArray| 
+% C++ Signature: unsigned long long NITCamArray::ringOverflows()
+
+NITCamArrayRingOverflowsDefinition = addMethod(NITCamArrayDefinition, ...
+    "unsigned long long NITCamArray::ringOverflows()", ...
+    "MATLABName", "ringOverflows", ...
+    "Description", "ringOverflows Method of C++ class NITCamArray." + newline + ...
+    "Frames dropped by the rings of all cameras since arm because they were full"); % Modify help description values as needed.
+defineOutput(NITCamArrayRingOverflowsDefinition, "RetVal", "uint64");
+validate(NITCamArrayRingOverflowsDefinition);
+
 %% C++ class |NITLibrary::NITConfigObserver| with MATLAB name |clib.NITCam.NITLibrary.NITConfigObserver| 
 NITConfigObserverDefinition = addClass(libDef, "NITLibrary::NITConfigObserver", "MATLABName", "clib.NITCam.NITLibrary.NITConfigObserver", ...
     "Description", "clib.NITCam.NITLibrary.NITConfigObserver    Representation of C++ class NITLibrary::NITConfigObserver." + newline + ...
@@ -0,0 +1,43 @@
+function [meta, info] = readNITMetadata(fileName)
+% readNITMetadata  Read a metadata sidecar written by captureFrames (setMetadataSidecar) or writeMetadata
+%
+%   [meta, info] = readNITMetadata(fileName)
+%
+%   meta    struct with one column vector per field, one row per frame in capture order:
+%           id (uint64), hostTime (seconds on the monotonic host clock), temperature (single),
+%           timestamp, exposureTime and triggerDelay (us), gatedMode (logical)
+%           Gaps in diff(meta.id) are dropped frames.
+%   info    header fields (version, frameCount, overflows, ...)
+
+fid = fopen(fileName, 'r', 'ieee-le');
+if fid < 0
+    error('readNITMetadata:open', 'Cannot open %s', fileName);
+end
+magic = fread(fid, 8, '*char').';
+if ~strcmp(magic(1:7), 'NITMETA')
+    fclose(fid);
+    error('readNITMetadata:format', '%s is not a NITCam metadata file', fileName);
+end
+info.version = fread(fid, 1, 'uint32');
+info.headerSize = fread(fid, 1, 'uint32');
+info.columnCount = fread(fid, 1, 'uint32');
+fread(fid, 1, 'uint32'); % reserved
+info.frameCount = fread(fid, 1, 'uint64');
+info.overflows = fread(fid, 1, 'uint64');
+
+% the columns follow the header one after the other
+n = info.frameCount;
+fseek(fid, info.headerSize, 'bof');
+meta.id = fread(fid, n, '*uint64');
+meta.hostTime = fread(fid, n, 'double');
+meta.temperature = fread(fid, n, '*single');
+meta.timestamp = fread(fid, n, 'double');
+meta.exposureTime = fread(fid, n, 'double');
+meta.triggerDelay = fread(fid, n, 'double');
+meta.gatedMode = logical(fread(fid, n, 'uint8'));
+fclose(fid);
+
+if info.overflows > 0
+    warning('readNITMetadata:overflow', '%d frames did not fit into the metadata of %s', info.overflows, fileName);
+end
+end
@@ -0,0 +1,74 @@
+function [frames, index, info] = readNITSequence(fileName)
+% readNITSequence  Memory-map a sequence file recorded with captureFrames(..., 'seq', ...)
+%
+%   [frames, index, info] = readNITSequence(fileName)
+%
+%   frames  memmapfile of the pixels, frames.Data.pixels is columns x rows x frameCount
+%           (uint16 for 14-bit recordings, uint8 for gain controlled ones).
+%           Nothing is read until it is indexed, e.g. one image:
+%               img = frames.Data.pixels(:, :, k).';
+%   index   struct with the per frame vectors id, temperature and timestamp
+%           (zeros if the recording was not closed, see SequenceFormat.h)
+%   info    header fields (width, height, bitDepth, frameCount, ...)
+
+fid = fopen(fileName, 'r', 'ieee-le');
+if fid < 0
+    error('readNITSequence:open', 'Cannot open %s', fileName);
+end
+magic = fread(fid, 8, '*char').';
+if ~strcmp(magic(1:6), 'NITSEQ')
+    fclose(fid);
+    error('readNITSequence:format', '%s is not a NITCam sequence file', fileName);
+end
+info.version = fread(fid, 1, 'uint32');
+info.headerSize = fread(fid, 1, 'uint32');
+info.width = fread(fid, 1, 'uint32');
+info.height = fread(fid, 1, 'uint32');
+info.bitDepth = fread(fid, 1, 'uint32');
+info.indexEntrySize = fread(fid, 1, 'uint32');
+info.frameCount = fread(fid, 1, 'uint64');
+info.frameBytes = fread(fid, 1, 'uint64');
+info.dataOffset = fread(fid, 1, 'uint64');
+info.indexOffset = fread(fid, 1, 'uint64');
+fclose(fid);
+
+closed = info.frameCount > 0;
+if ~closed
+    % not closed: recover the frames that fit before the reserved index, there is no index
+    fileBytes = dir(fileName).bytes;
+    dataEnd = fileBytes;
+    if info.indexOffset >= info.dataOffset && info.indexOffset < fileBytes
+        dataEnd = info.indexOffset;
+    end
+    info.frameCount = floor((dataEnd - info.dataOffset) / info.frameBytes);
+    warning('readNITSequence:unclosed', ...
+        '%s was not closed, recovered %d frames without index (frames never written are blank)', fileName, info.frameCount);
+    if info.frameCount == 0
+        frames = [];
+        index = struct('id', zeros(0, 1, 'uint64'), 'temperature', zeros(0, 1, 'single'), 'timestamp', zeros(0, 1));
+        return;
+    end
+end
+
+if info.bitDepth == 8
+    pixelType = 'uint8';
+else
+    pixelType = 'uint16';
+end
+% the file is row major, so a frame maps to columns x rows
+frames = memmapfile(fileName, 'Offset', info.dataOffset, ...
+    'Format', {pixelType, [info.width info.height info.frameCount], 'pixels'}, ...
+    'Repeat', 1);
+
+if ~closed
+    index = struct('id', zeros(info.frameCount, 1, 'uint64'), 'temperature', zeros(info.frameCount, 1, 'single'), ...
+        'timestamp', zeros(info.frameCount, 1));
+    return;
+end
+entries = memmapfile(fileName, 'Offset', info.indexOffset, ...
+    'Format', {'uint64', [1 1], 'id'; 'single', [1 1], 'temperature'; 'uint32', [1 1], 'reserved'; 'double', [1 1], 'timestamp'}, ...
+    'Repeat', info.frameCount);
+index.id = [entries.Data.id].';
+index.temperature = [entries.Data.temperature].';
+index.timestamp = [entries.Data.timestamp].';
+end
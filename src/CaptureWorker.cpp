@@ -0,0 +1,115 @@
+#include "CaptureWorker.h"
+
+#include <chrono>
+
+CaptureWorker::CaptureWorker() : lastHandle(0), running(false), succeeded(false), collected(true), quit(false)
+{
+}
+
+CaptureWorker::~CaptureWorker()
+{
+    shutdown();
+}
+
+unsigned int CaptureWorker::start(const std::function<bool(unsigned int)>& new_job)
+{
+    unsigned int handle;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if( running )
+            return 0;
+        job = new_job;
+        running = true;
+        succeeded = false;
+        collected = false;
+        quit = false;
+        // 0 is "no handle", skip it when the counter wraps
+        if( ++lastHandle == 0 )
+            lastHandle = 1;
+        handle = lastHandle;
+    }
+    if( !worker.joinable() )
+        worker = std::thread(&CaptureWorker::run, this);
+    wakeUp.notify_one();
+    return handle;
+}
+
+bool CaptureWorker::isDone(unsigned int handle)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return handle != 0 && handle <= lastHandle && (handle != lastHandle || !running);
+}
+
+bool CaptureWorker::wait(unsigned int handle, int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    if( handle == 0 || handle > lastHandle )
+        return false;
+    auto done = [this, handle] { return handle != lastHandle || !running; };
+    if( timeout_ms < 0 )
+    {
+        finished.wait(lock, done);
+        return true;
+    }
+    return finished.wait_for(lock, std::chrono::milliseconds(timeout_ms), done);
+}
+
+bool CaptureWorker::result(unsigned int handle, bool& job_succeeded)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    if( handle == 0 || handle != lastHandle )
+        return false;
+    finished.wait(lock, [this] { return !running; });
+    if( collected )
+        return false;
+    collected = true;
+    job_succeeded = succeeded;
+    return true;
+}
+
+void CaptureWorker::shutdown()
+{
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        finished.wait(lock, [this] { return !running; });
+        quit = true;
+    }
+    wakeUp.notify_one();
+    if( worker.joinable() )
+        worker.join();
+}
+
+void CaptureWorker::run()
+{
+    for(;;)
+    {
+        std::function<bool(unsigned int)> current;
+        unsigned int handle;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wakeUp.wait(lock, [this] { return quit || (running && job); });
+            if( quit && !running )
+                return;
+            current.swap(job);
+            handle = lastHandle;
+        }
+
+        // an exception must not end the thread with running still set
+        bool ok = false;
+        try
+        {
+            ok = current(handle);
+        }
+        catch( ... )
+        {
+            ok = false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            succeeded = ok;
+            running = false;
+        }
+        finished.notify_all();
+    }
+}
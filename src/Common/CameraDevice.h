@@ -0,0 +1,59 @@
+#ifndef CAMERADEVICE_H_INCLUDED
+#define CAMERADEVICE_H_INCLUDED
+
+#include <NITDevice.h>
+#include <NITFilter.h>
+#include <NITConfigObserver.h>
+
+#include <cstddef>
+#include <string>
+
+/** The camera as NITCam drives it                                                           **/
+/**                                                                                           **/
+/** The subset of the NITDevice API NITCam, NITCamArray and ConfigureDevice use, with the     **/
+/** same names and the same contract. SdkDevice forwards it to a device of the NITManager,   **/
+/** SimulatedDevice implements it without hardware: NITDevice itself can't be derived from   **/
+/** outside the SDK, its constructor is not exported.                                        **/
+class CameraDevice
+{
+    public:
+        virtual ~CameraDevice() {}
+
+        virtual unsigned int sensorWidth() const = 0;
+        virtual unsigned int sensorHeight() const = 0;
+        virtual NITLibrary::ConnectorType connectorType() const = 0;
+        virtual std::string commercialName() const = 0;
+        virtual std::string serialNumber() const = 0;
+
+        virtual void activateNuc(bool activate = true) = 0;
+        virtual void activateBpr(bool activate = true) = 0;
+        virtual bool nucActive() const = 0;
+        virtual bool bprActive() const = 0;
+        virtual void setNucDirectory(const std::string& dir_path, bool is_bpr_path = true) = 0;
+        virtual void setNucFile(const std::string& file_path) = 0;
+        virtual void setBprFile(const std::string& file_path) = 0;
+
+        virtual void setFps(double new_fps) = 0;
+        virtual double fps() const = 0;
+        virtual double minFps() const = 0;
+        virtual double maxFps() const = 0;
+
+        /** Parameters are staged by setParamValueOf and sent to the camera by updateConfig **/
+        virtual double paramValueOf(const std::string& param_name) const = 0;
+        virtual std::string paramStrValueOf(const std::string& param_name) const = 0;
+        virtual CameraDevice& setParamValueOf(const std::string& param_name, unsigned int value) = 0;
+        virtual CameraDevice& setParamValueOf(const std::string& param_name, double value) = 0;
+        virtual CameraDevice& setParamValueOf(const std::string& param_name, const std::string& value) = 0;
+        virtual void updateConfig() = 0;
+
+        virtual void start() = 0;
+        virtual void captureNFrames(size_t n, bool error_increment_count = false) = 0;
+        virtual void stop() = 0;
+        virtual bool waitEndCapture(int timeout = -1) = 0;
+
+        /** Connect the head of the pipeline, before streaming starts **/
+        virtual NITLibrary::NITFilter& operator<<(NITLibrary::NITFilter& filter) = 0;
+        virtual void operator<<(NITLibrary::NITConfigObserver& observer) = 0;
+};
+
+#endif // CAMERADEVICE_H_INCLUDED
@@ -16,6 +16,8 @@
 #define SenS_1280VS        12
 #define WiDySenS_320VS     13
 
+#define SIMULATED_DEVICE   14
+
 /** Uncomment the line below which correspond to your camera model **/
 // USB
 //#define CAMERA_MODEL WIDySWIR_640VS     //NSC1201
@@ -34,6 +36,9 @@
 //#define CAMERA_MODEL MC1003_1GB         //NSC1003GIGE
 //#define CAMERA_MODEL MC1003_1GF         //NSC1003cGIGE
 
+// No hardware
+//#define CAMERA_MODEL SIMULATED_DEVICE   //Software camera, see SimulatedDevice.h
+
 
 #if CAMERA_MODEL == WIDySWIR_640VS        //NSC1201
     #include "ConfigureWiDySwir640VS.h"
@@ -62,6 +67,8 @@
     #include "ConfigureMC1003GB.h"
 #elif CAMERA_MODEL == MC1003_1GF          //NSC1003cGIGE
     #include "ConfigureMC1003GF.h"
+#elif CAMERA_MODEL == SIMULATED_DEVICE     //Software camera
+    #include "ConfigureSimulatedDevice.h"
 #endif // CAMERA_MODEL
 
 #endif // CAMERASELECTOR_H_INCLUDED
@@ -0,0 +1,46 @@
+#ifndef CAPTUREWORKER_H_INCLUDED
+#define CAPTUREWORKER_H_INCLUDED
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/** One background thread that runs captures while the caller goes on                      **/
+/** A job gets a handle, the caller polls it with isDone(), blocks on it with wait() and     **/
+/** collects its result with result(). One job runs at a time: start() refuses a new job    **/
+/** until the running one has finished. Only the last job is remembered, earlier handles    **/
+/** count as done but have no result anymore.                                               **/
+/** The thread is created with the first job and sleeps between jobs.                       **/
+class CaptureWorker
+{
+    public:
+        CaptureWorker();
+        /** Waits for the running job **/
+        ~CaptureWorker();
+
+        /** Run job(handle) on the worker thread, returns the handle (> 0) or 0 if a job is still running **/
+        unsigned int start(const std::function<bool(unsigned int)>& job);
+        /** True if the job of handle has finished (or was replaced by a newer job) **/
+        bool isDone(unsigned int handle);
+        /** Wait at most timeout_ms (negative: no limit) for the job, true if it has finished **/
+        bool wait(unsigned int handle, int timeout_ms);
+        /** Wait for the job and hand out its result once, false if handle has no result (anymore) **/
+        bool result(unsigned int handle, bool& succeeded);
+
+        /** Wait for the running job and end the thread, start() creates it again **/
+        void shutdown();
+
+    private:
+        std::thread worker;
+        std::mutex stateMutex;
+        std::condition_variable wakeUp, finished;
+
+        std::function<bool(unsigned int)> job;
+        unsigned int lastHandle;
+        bool running, succeeded, collected, quit;
+
+        void run();
+};
+
+#endif // CAPTUREWORKER_H_INCLUDED
@@ -0,0 +1,26 @@
+#ifndef CONFIGURESIMULATEDDEVICE_H_INCLUDED
+#define CONFIGURESIMULATEDDEVICE_H_INCLUDED
+
+#include <iostream>
+
+#include "CameraDevice.h"
+
+/** Configuration of the simulated camera (see SimulatedDevice.h)                  **/
+/*                                                                                 */
+/* No camera and no driver are needed. Select SIMULATED_DEVICE in CameraSelector.h:*/
+/* CreateSimulatedDevice.cpp, SimulatedDevice.cpp and ConfigureSimulatedDevice.cpp */
+/* are built instead of CreateUsbDevice.cpp and the Configure*.cpp of the camera,  */
+/* all of them can stay in the source list.                                        */
+/* The sensor size and the highest frame rate can be changed below.                */
+/* SIMULATED_CAMERA_COUNT cameras are discovered by NITCamArray.                   */
+void ConfigureDevice(CameraDevice* dev);
+
+#define SIMULATED_SENSOR_WIDTH  640
+#define SIMULATED_SENSOR_HEIGHT 512
+#define SIMULATED_MAX_FPS       200.0
+#define SIMULATED_CAMERA_COUNT  2
+
+#define USE_SIMULATED
+#define NEED_AGC
+
+#endif // CONFIGURESIMULATEDDEVICE_H_INCLUDED
@@ -10,6 +10,7 @@
 #include <NITPlayer.h>
 #include <string>
 #include <NITSnapshot.h>
+#include "CameraDevice.h"
 
 /** This sample configuration is specific to WiDySenS 640-VST cameras                **/
 /*                                                                                   */
@@ -19,7 +20,7 @@
 /* Copy this SNxxx folder in the working directory of this application               */
 /* When the NITDevice object is constructed, he looks for the presence of this folder*/
 /*      enable automatically the Nuc processing                                      */
-void ConfigureDevice(NITLibrary::NITDevice* dev);
+void ConfigureDevice(CameraDevice* dev);
 
 #define USE_USB
 #define NEED_AGC
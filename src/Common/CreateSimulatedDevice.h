@@ -0,0 +1,22 @@
+#ifndef CREATESIMULATEDDEVICE_H_INCLUDED
+#define CREATESIMULATEDDEVICE_H_INCLUDED
+
+#include <iostream>
+
+#include "CameraDevice.h"
+#include <NITFilter.h>
+#include <NITAutomaticGainControl.h>
+#include <NITPlayer.h>
+#include <string>
+#include <vector>
+#include <NITSnapshot.h>
+
+/** Same entry points as CreateUsbDevice.h, return SimulatedDevices **/
+CameraDevice* CreateDevice();
+CameraDevice* CreateDevice(const std::string& serial_number);
+/** SIMULATED_CAMERA_COUNT serial numbers SIM0001, SIM0002, ... **/
+std::vector< std::string > DiscoverSerialNumbers();
+/** Like the NITManager a serial number can only be opened again once its device is released **/
+void ReleaseDevice(CameraDevice* dev);
+
+#endif // CREATESIMULATEDDEVICE_H_INCLUDED
@@ -10,8 +10,16 @@
 #include <NITAutomaticGainControl.h>
 #include <NITPlayer.h>
 #include <string>
+#include <vector>
 #include <NITSnapshot.h>
+#include "CameraDevice.h"
 
-NITLibrary::NITDevice* CreateDevice();
+CameraDevice* CreateDevice();
+/** Open the camera with the given serial number, NULL if there is none **/
+CameraDevice* CreateDevice(const std::string& serial_number);
+/** Serial numbers of the discovered cameras **/
+std::vector< std::string > DiscoverSerialNumbers();
+/** Hand a device back to the NITManager, it can be opened again afterwards **/
+void ReleaseDevice(CameraDevice* dev);
 
 #endif // CREATEUSBDEVICE_H_INCLUDED
@@ -0,0 +1,47 @@
+#ifndef DARKFRAMEFILTER_H_INCLUDED
+#define DARKFRAMEFILTER_H_INCLUDED
+
+#include <NITFilter.h>
+#include <NITFrame.h>
+
+#include <vector>
+#include <memory>
+#include <atomic>
+
+/** Subtracts a dark (ambient) reference frame and clamps at 0, before the gain controls      **/
+/**                                                                                           **/
+/** The reference is rounded to whole levels when it is set, so the 14-bit frames stay whole **/
+/** numbers. Like NucFilter the reference is swapped by pointer and frames of another size    **/
+/** pass through unchanged.                                                                    **/
+class DarkFrameFilter : public NITLibrary::NITFilter
+{
+    public:
+        DarkFrameFilter();
+        ~DarkFrameFilter();
+
+        /** Use dark (rows x columns, row major) as reference **/
+        void setReference(unsigned int rows, unsigned int columns, const float* dark);
+        void clearReference();
+        bool hasReference() const;
+
+        /** Current reference, NULL if none; rows x columns values **/
+        const float* reference(unsigned int& rows, unsigned int& columns) const;
+
+        unsigned long long corrected() const    { return correctedCount.load(); }    //!< Frames the reference was subtracted from
+        unsigned long long mismatches() const   { return mismatchCount.load(); }     //!< Frames passed through because of their dimensions
+
+    private:
+        struct Reference
+        {
+            unsigned int rows, columns;
+            std::vector< float > pixels;
+        };
+
+        std::shared_ptr<const Reference> current;   // only accessed with std::atomic_load / atomic_store
+        std::atomic<unsigned long long> correctedCount, mismatchCount;
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(NITLibrary::NITFrame& frame);
+};
+
+#endif // DARKFRAMEFILTER_H_INCLUDED
@@ -0,0 +1,90 @@
+#ifndef FASTAUTOMATICGAINCONTROL_H_INCLUDED
+#define FASTAUTOMATICGAINCONTROL_H_INCLUDED
+
+#include <NITFilter.h>
+#include <NITFrame.h>
+#include <NITAutomaticGainControl.h>        // NITToolBox::Roi
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+#include "WorkerPool.h"
+
+/** Drop-in replacement for NITAutomaticGainControl                                          **/
+/**                                                                                          **/
+/** The clip points come from a 14-bit histogram built over row bands on a WorkerPool, each  **/
+/** band in its own histogram, and the frame is stretched in place like FastManualGainControl. **/
+/** The histogram can be restricted to a Roi and to every n-th row and column. The ignored   **/
+/** pixel counts are given for the full frame and scaled to the number of sampled pixels.     **/
+/**                                                                                          **/
+/** The min/max are smoothed over frames and the histogram is only rebuilt every            **/
+/** refresh_interval frames. In between, the mean of a sparse grid is compared with the mean  **/
+/** at the last rebuild: a scene change rebuilds at once and drops the smoothing.             **/
+/** The defaults (every pixel, every frame, no smoothing) match the SDK filter.                **/
+class FastAutomaticGainControl : public NITLibrary::NITFilter
+{
+    public:
+        /** thread_count 0 uses one thread per hardware thread, see WorkerPool **/
+        FastAutomaticGainControl(unsigned int ignored_below = 200, unsigned int ignored_above = 200, unsigned int thread_count = 0);
+        ~FastAutomaticGainControl();
+
+        /** Number of pixels to ignore on each side of the histogram **/
+        void setIgnoredPixels(unsigned int pixels_below, unsigned int pixels_above);
+        void getIgnoredPixels(unsigned int& pixels_below, unsigned int& pixels_above) const;
+        /** Last min and max value used for the stretching **/
+        void getMinMaxValue(unsigned short& min_value, unsigned short& max_value) const;
+
+        /** Build the histogram on every step-th row and column, 1 = every pixel **/
+        void setSubsample(unsigned int step);
+        /** Build the histogram on this region only, an empty Roi uses the full frame **/
+        void setRoi(const NITLibrary::NITToolBox::Roi& roi);
+        /** smoothing: weight of the new min/max in the running values (1 = no smoothing)            **/
+        /** refresh_interval: frames between two histograms (1 = every frame)                        **/
+        /** scene_change: change of the mean level, as a fraction of max - min, that forces a rebuild **/
+        void setTemporalFilter(float smoothing, unsigned int refresh_interval, float scene_change);
+        /** Forget the smoothed min/max, the next frame rebuilds the histogram **/
+        void reset() { resetPending.store(true); }
+
+        unsigned long long histograms() const   { return histogramCount.load(); }   //!< Histograms built since construction
+        unsigned long long sceneChanges() const { return sceneChangeCount.load(); } //!< Rebuilds forced by a scene change
+
+    private:
+        struct Settings
+        {
+            unsigned int ignoredBelow, ignoredAbove;
+            unsigned int subsample;
+            NITLibrary::NITToolBox::Roi roi;
+            float smoothing;
+            unsigned int refreshInterval;
+            float sceneChange;
+        };
+
+        mutable std::mutex settingsMutex;       // settings are changed from the main thread
+        Settings settings;
+
+        WorkerPool pool;
+        std::vector< std::vector< unsigned int > > bandHistograms;     // one per band, merged into histogram
+        std::vector< unsigned int > histogram;
+
+        // streaming thread state
+        bool primed;
+        float minLevel, maxLevel;
+        float referenceMean;
+        unsigned int framesSinceHistogram;
+
+        std::atomic<bool> resetPending;
+        std::atomic<unsigned int> limits;       // min | max << 16
+        std::atomic<unsigned long long> histogramCount, sceneChangeCount;
+
+        size_t buildHistogram(const float* pixels, unsigned int columns, unsigned int top, unsigned int bottom,
+                              unsigned int left, unsigned int right, unsigned int step);
+        void clipPoints(size_t below, size_t above, float& low, float& high) const;
+        static float sparseMean(const float* pixels, unsigned int columns, unsigned int top, unsigned int bottom,
+                                unsigned int left, unsigned int right);
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(NITLibrary::NITFrame& frame);
+};
+
+#endif // FASTAUTOMATICGAINCONTROL_H_INCLUDED
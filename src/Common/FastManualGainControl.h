@@ -0,0 +1,41 @@
+#ifndef FASTMANUALGAINCONTROL_H_INCLUDED
+#define FASTMANUALGAINCONTROL_H_INCLUDED
+
+#include <NITFilter.h>
+#include <NITFrame.h>
+
+#include <atomic>
+#include <cstddef>
+
+/** Drop-in replacement for NITManualGainControl                                            **/
+/**                                                                                         **/
+/** Stretches [low, high] to [0, 255] with the SIMD kernels of GainKernels.h. NITFilter      **/
+/** frames are float, so the stretch is done in place: the frame is its own output buffer    **/
+/** and nothing is allocated per frame. Sinks that want bytes pack the 0..255 values with    **/
+/** packUint8(), or call convert() directly on raw 14-bit pixels.                            **/
+/** The limits live in a single atomic word, setMinMaxValue() can be called while streaming. **/
+class FastManualGainControl : public NITLibrary::NITFilter
+{
+    public:
+        FastManualGainControl(unsigned short low_limit, unsigned short high_limit);
+        ~FastManualGainControl();
+
+        /** Set new values to compute the stretching **/
+        void setMinMaxValue(unsigned short low_limit, unsigned short high_limit);
+        /** Current stretching values **/
+        void getMinMaxValue(unsigned short& min_value, unsigned short& max_value) const;
+
+        /** Stretch count pixels into dst with the current limits **/
+        void convert(const unsigned short* src, unsigned char* dst, size_t count) const;
+        void convert(const float* src, unsigned char* dst, size_t count) const;
+
+    private:
+        std::atomic<unsigned int> limits;      // low | high << 16
+
+        void scaleOffset(float& scale, float& offset) const;
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(NITLibrary::NITFrame& frame);
+};
+
+#endif // FASTMANUALGAINCONTROL_H_INCLUDED
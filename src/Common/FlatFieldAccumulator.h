@@ -0,0 +1,58 @@
+#ifndef FLATFIELDACCUMULATOR_H_INCLUDED
+#define FLATFIELDACCUMULATOR_H_INCLUDED
+
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/** Streaming per-pixel mean and standard deviation of a flat field                          **/
+/**                                                                                          **/
+/** Each frame is folded into a Welford accumulator, no frame is kept. Once a pixel has       **/
+/** WARMUP_FRAMES samples, a sample further than reject_sigma standard deviations from its     **/
+/** running mean (at least one level) is left out and counted in rejectedSamples(), so a      **/
+/** glitch in a few frames doesn't shift the calibration.                                      **/
+class FlatFieldAccumulator : public NITLibrary::NITObserver
+{
+    public:
+        FlatFieldAccumulator();
+        ~FlatFieldAccumulator();
+
+        /** Start accumulating frame_count frames of rows x columns pixels, reject_sigma <= 0 keeps every sample **/
+        void arm(unsigned int frame_count, unsigned int rows, unsigned int columns, float reject_sigma);
+        /** Stop accumulating, the results stay available **/
+        void disarm();
+
+        unsigned int frames();                          //!< Frames accumulated since arm()
+        unsigned int droppedFrames();                   //!< Frames rejected because of their dimensions
+        /** Block until count frames are accumulated, false if a frame was dropped or deadline passed first **/
+        bool waitForFrames(unsigned int count, const std::chrono::steady_clock::time_point& deadline);
+        unsigned long long rejectedSamples();           //!< Pixel samples left out as outliers
+        unsigned int rows() const       { return frameRows; }
+        unsigned int columns() const    { return frameColumns; }
+
+        /** Per-pixel mean and standard deviation of the accumulated frames (rows x columns) **/
+        void result(std::vector< float >& mean, std::vector< float >& stddev);
+
+    private:
+        std::mutex accumulatorMutex;
+        std::condition_variable frameCondition;     // signalled for every frame, see waitForFrames
+        std::vector< double > means, squares;       // Welford mean and sum of squared differences
+        std::vector< unsigned int > counts;
+
+        bool armed;
+        unsigned int frameRows, frameColumns;
+        unsigned int capacity, accumulated, dropped;
+        unsigned long long rejected;
+        float rejectSigma;
+
+        void accumulate(const NITLibrary::NITFrame& frame);
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // FLATFIELDACCUMULATOR_H_INCLUDED
@@ -0,0 +1,54 @@
+#ifndef FRAMEAVERAGER_H_INCLUDED
+#define FRAMEAVERAGER_H_INCLUDED
+
+#include <mutex>
+#include <vector>
+
+#include "FrameRelay.h"
+
+/** Temporal averaging in the stream, before the gain controls and the sinks               **/
+/**                                                                                         **/
+/** OFF:          every frame goes on unchanged                                             **/
+/** RUNNING_MEAN: every frame is replaced by the mean of all frames since the last reset    **/
+/** EMA:          every frame is replaced by mean += alpha * (frame - mean)                  **/
+/** BLOCK:        n frames are summed, only their mean goes on, so sinks see 1/n of the frames **/
+/** The sums are kept in float accumulators with AVX/SSE kernels, the running mean is updated **/
+/** incrementally so it doesn't lose precision over long runs. The frame that goes on is a   **/
+/** copy in a buffer of its own (see FrameRelay), the gain controls behind work in place     **/
+/** without touching the accumulators.                                                      **/
+/** The averaged frame takes Id, temperature and timestamp of the last frame it contains.    **/
+class FrameAverager : public FrameRelay
+{
+    public:
+        enum eMode { OFF, RUNNING_MEAN, EMA, BLOCK };
+
+        FrameAverager();
+        ~FrameAverager();
+
+        /** Change the averaging and drop the frames accumulated so far            **/
+        /** parameter: alpha for EMA (0..1], block size for BLOCK, ignored otherwise **/
+        void setMode(eMode mode, double parameter);
+        eMode mode() const;
+        /** The parameter of the current mode, setMode(mode(), parameter()) restores the averaging **/
+        double parameter() const;
+        /** Drop the frames accumulated so far **/
+        void reset();
+
+        /** Number of frames a capture has to request to get frame_count frames out of the averager **/
+        unsigned int inputFrames(unsigned int frame_count) const;
+
+    private:
+        mutable std::mutex averagerMutex;
+        eMode averageMode;
+        float alpha;
+        unsigned int blockSize;
+
+        std::vector< float > accumulator;
+        unsigned int accumulated;
+        unsigned int frameRows, frameColumns;
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // FRAMEAVERAGER_H_INCLUDED
@@ -0,0 +1,82 @@
+#ifndef FRAMEBUFFER_H_INCLUDED
+#define FRAMEBUFFER_H_INCLUDED
+
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/** This observer collects frames into one preallocated contiguous buffer                  **/
+/** The layout is frames x rows x columns (row major), each frame directly after the other.  **/
+/** Column major buffers hold frames x columns x rows instead: the layout of a MATLAB        **/
+/** rows x columns x frames array, written in one pass with the conversion.                  **/
+/** 14-bit frames are stored as unsigned short, gain controlled frames as unsigned char,     **/
+/** or both as float.                                                                         **/
+/** The buffers are kept between captures so a capture of the same size doesn't allocate.   **/
+/** With setAveraging(n) each slot holds the mean of n consecutive frames.                  **/
+class FrameBuffer : public NITLibrary::NITObserver
+{
+    public:
+        enum ePixelFormat { UINT16, UINT8, SINGLE };
+
+        FrameBuffer();
+        ~FrameBuffer();
+
+        /** Size the buffer for frame_count frames of rows x columns pixels and start collecting **/
+        /** Frames with other dimensions are dropped and counted in droppedFrames()            **/
+        void arm(unsigned int frame_count, unsigned int rows, unsigned int columns, ePixelFormat format, bool column_major = false);
+        /** Stop collecting, the collected frames stay available **/
+        void disarm();
+        /** Average the next frames_per_slot frames into each slot, 1 stores every frame **/
+        /** A partially accumulated slot is discarded                                   **/
+        void setAveraging(unsigned int frames_per_slot);
+
+        unsigned int frames();          //!< Number of filled slots
+        unsigned int droppedFrames();   //!< Number of frames rejected because of their dimensions
+        /** Block until count slots are filled, false if a frame was dropped or deadline passed first **/
+        bool waitForFrames(unsigned int count, const std::chrono::steady_clock::time_point& deadline);
+        unsigned int rows() const       { return frameRows; }
+        unsigned int columns() const    { return frameColumns; }
+        ePixelFormat format() const     { return pixelFormat; }
+        bool columnMajor() const        { return useColumnMajor; }
+
+        /** Pointer to the collected pixels, NULL if the buffer holds another pixel type **/
+        const unsigned short* data16() const { return pixelFormat == UINT16 ? pixels16.data() : NULL; }
+        const unsigned char* data8() const   { return pixelFormat == UINT8 ? pixels8.data() : NULL; }
+        const float* dataSingle() const      { return pixelFormat == SINGLE ? pixelsSingle.data() : NULL; }
+
+        /** Number of pixels of the collected frames (frames x rows x columns) **/
+        size_t size();
+
+        /** Exchange the collected frames with other, both buffers must be disarmed         **/
+        /** Two buffers swapped after every capture form a double buffer: one is read while **/
+        /** the other one fills, and neither allocates once both have the capture size.     **/
+        void swap(FrameBuffer& other);
+
+    private:
+        std::mutex bufferMutex;
+        std::condition_variable frameCondition;     // signalled for every frame, see waitForFrames
+        std::vector< unsigned short > pixels16;
+        std::vector< unsigned char > pixels8;
+        std::vector< float > pixelsSingle;
+
+        bool armed;
+        ePixelFormat pixelFormat;
+        bool useColumnMajor;
+        unsigned int frameRows, frameColumns;
+        unsigned int capacity, collected, dropped;
+
+        std::vector< float > accumulator;
+        unsigned int framesPerSlot, accumulated;
+
+        void store(const float* src, float scale);
+        void collect(const NITLibrary::NITFrame& frame);
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // FRAMEBUFFER_H_INCLUDED
@@ -0,0 +1,76 @@
+#ifndef FRAMEMETADATATABLE_H_INCLUDED
+#define FRAMEMETADATATABLE_H_INCLUDED
+
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include "FrameStatistics.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+/** This observer records one row of metadata per frame into preallocated columns          **/
+/** A row holds the frame Id, the host receive time on the monotonic clock, the sensor      **/
+/** temperature and timestamp of the frame and the capture settings it was taken with.     **/
+/** The receive time is the one FrameStatistics took at the head of the pipeline, if the   **/
+/** table is attached to it, so it doesn't include the work of the filters in between.     **/
+/** The columns are contiguous so each one can be handed to MATLAB or written at once:     **/
+/** the pixels of image files lose this information, a .meta sidecar keeps it.             **/
+/** Host times are seconds of std::chrono::steady_clock, comparable between cameras of the **/
+/** same process but with an arbitrary origin.                                              **/
+class FrameMetadataTable : public NITLibrary::NITObserver
+{
+    public:
+        FrameMetadataTable();
+        ~FrameMetadataTable();
+
+        /** Size the table for frame_count frames, drop the recorded rows and start recording **/
+        /** Frames beyond frame_count are counted in overflows()                              **/
+        void arm(unsigned int frame_count);
+        /** Stop recording, the recorded rows stay available **/
+        void disarm();
+        /** Settings stored with the following frames, set them when they reach the device **/
+        void setSettings(bool gated_mode, double trigger_delay, double exposure_time);
+        /** Take the host times from the head of the pipeline instead of the end of it **/
+        void attachArrivals(const FrameStatistics* statistics);
+
+        unsigned int frames();          //!< Number of recorded rows
+        unsigned int overflows();       //!< Number of frames that didn't fit into the table
+
+        /** Columns of the recorded rows, frames() values each **/
+        const unsigned long long* ids() const       { return idColumn.data(); }
+        const double* hostTimes() const             { return hostTimeColumn.data(); }
+        const float* temperatures() const           { return temperatureColumn.data(); }
+        const double* timestamps() const            { return timestampColumn.data(); }
+        const double* exposureTimes() const         { return exposureColumn.data(); }
+        const double* triggerDelays() const         { return delayColumn.data(); }
+        const unsigned char* gatedModes() const     { return gatedColumn.data(); }
+
+        /** Write the recorded rows to a sidecar file, see MetadataFormat.h **/
+        bool write(const std::string& file_name);
+
+        /** Exchange the recorded rows with other, both tables must be disarmed **/
+        void swap(FrameMetadataTable& other);
+
+    private:
+        std::mutex tableMutex;
+        std::vector< unsigned long long > idColumn;
+        std::vector< double > hostTimeColumn;
+        std::vector< float > temperatureColumn;
+        std::vector< double > timestampColumn;
+        std::vector< double > exposureColumn;
+        std::vector< double > delayColumn;
+        std::vector< unsigned char > gatedColumn;
+
+        const FrameStatistics* arrivalSource;
+        bool armed;
+        unsigned int recorded, dropped;
+        bool gatedMode;
+        double triggerDelay, exposureTime;
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // FRAMEMETADATATABLE_H_INCLUDED
@@ -0,0 +1,58 @@
+#ifndef FRAMERELAY_H_INCLUDED
+#define FRAMERELAY_H_INCLUDED
+
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include <cstddef>
+#include <vector>
+
+/** Observer that hands frames on to its own downstream filters and observers              **/
+/**                                                                                         **/
+/** An SDK filter has to pass every frame it gets, a relay decides which frames go on and   **/
+/** may send frames of its own (an average, a transformed copy). Derived classes implement  **/
+/** onNewFrame() and call forward().                                                          **/
+/** The downstream list is not locked: connect before streaming starts. The downstream       **/
+/** connectables are driven by the relay only, don't also connect them with operator<<.      **/
+/**                                                                                         **/
+/** SDK assumptions (not part of the documented API, check them on an SDK update):          **/
+/** - Connectable::onNewImage() is public but documented as SDK internal. It is the call a  **/
+/**   NITDevice or NITFilter makes on its next stage, the relay makes the same call.        **/
+/** - NITFrame(bits, float*, width, height, id, temperature, ticks) is exported but not     **/
+/**   documented. The frame only points to the data: the device builds its frames on its   **/
+/**   own transfer buffers the same way, ~NITFrame doesn't free them.                       **/
+/** - A connectable with more than one connection (agc in NITCam) runs every branch in its  **/
+/**   own thread, so a branch may still read a frame after forward() returned. Frames sent **/
+/**   from outputBuffer() stay untouched for the next FORWARD_BUFFERS - 1 forwards, which   **/
+/**   is the same grace the device's transfer buffers give.                                 **/
+class FrameRelay : public NITLibrary::NITObserver
+{
+    public:
+        /** Number of buffers outputBuffer() rotates through **/
+        static const unsigned int FORWARD_BUFFERS = 8;
+
+        FrameRelay();
+        ~FrameRelay();
+
+        /** Send the frames to next (a NITFilter chain or a NITObserver) **/
+        FrameRelay& operator<<(Connectable& next);
+        /** Drop all downstream connectables **/
+        void disconnectDownstream();
+
+    protected:
+        /** Hand frame to every downstream connectable, in connection order **/
+        /** Downstream filters work in place: pass a frame you can give away **/
+        void forward(NITLibrary::NITFrame& frame);
+        /** Forward the frame received in onNewFrame() as is **/
+        void forward(const NITLibrary::NITFrame& frame);
+        /** Buffer of count floats for the next frame of the relay's own, the oldest of the ring **/
+        /** Not thread safe: call it from onNewFrame() (or under the lock of the derived class)  **/
+        float* outputBuffer(size_t count);
+
+    private:
+        std::vector< Connectable* > downstream;
+        std::vector< float > buffers[FORWARD_BUFFERS];
+        unsigned int nextBuffer;
+};
+
+#endif // FRAMERELAY_H_INCLUDED
@@ -0,0 +1,83 @@
+#ifndef FRAMERING_H_INCLUDED
+#define FRAMERING_H_INCLUDED
+
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include "FrameStatistics.h"
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+/** Single producer / single consumer ring of preallocated frame slots                     **/
+/**                                                                                         **/
+/** The pipeline thread copies each frame into the next free slot and never waits:          **/
+/** if the consumer is too slow the frame is dropped and counted in overflows().             **/
+/** The consumer reads the oldest slot with front() and hands it back with pop().            **/
+/** Producer and consumer only share two atomic indices, there is no lock on the frame path. **/
+/** allocate() may run while the ring is connected: it disables the ring and waits for the   **/
+/** frame in flight before it touches the slots.                                             **/
+/** Pixels are packed on the way in: unsigned short for 14-bit frames, unsigned char for     **/
+/** gain controlled frames.                                                                   **/
+class FrameRing : public NITLibrary::NITObserver
+{
+    public:
+        struct Slot
+        {
+            Slot() : rows(0), columns(0), id(0), temperature(0.0f), timestamp(0.0) {}
+            std::vector< unsigned short > pixels16;     // empty if the ring holds 8-bit frames
+            std::vector< unsigned char > pixels8;       // empty if the ring holds 14-bit frames
+            unsigned int rows, columns;
+            unsigned long long id;      // NITFrame::Id()
+            float temperature;          // NITFrame::temperature()
+            double timestamp;           // NITFrame::gigeTimestamp()
+            std::chrono::steady_clock::time_point received;     // host time the frame entered the pipeline
+        };
+
+        FrameRing();
+        ~FrameRing();
+
+        /** Allocate slot_count slots of rows x columns pixels and drop the queued frames **/
+        /** The ring is disabled afterwards, the consumer must not hold a slot            **/
+        void allocate(unsigned int slot_count, unsigned int rows, unsigned int columns, bool eight_bit);
+        /** Accept incoming frames or ignore them **/
+        void enable(bool state) { enabled.store(state); }
+        /** Take the received times from the head of the pipeline, call it before the ring is enabled **/
+        /** Without it, or for frames the statistics no longer hold, the ring times the frame itself  **/
+        void attachArrivals(const FrameStatistics* statistics)    { arrivalSource = statistics; }
+
+        /** Consumer side: oldest queued frame or NULL if the ring is empty **/
+        const Slot* front() const;
+        /** Consumer side: release the slot returned by front() **/
+        void pop();
+        /** Number of queued frames **/
+        unsigned int available() const;
+
+        unsigned int capacity() const           { return (unsigned int)slots.size(); }
+        bool eightBit() const                   { return useEightBit; }
+        unsigned long long pushed() const       { return pushCount.load(); }     //!< Frames stored since allocate()
+        unsigned long long overflows() const    { return overflowCount.load(); } //!< Frames dropped because the ring was full
+        unsigned long long mismatches() const   { return mismatchCount.load(); } //!< Frames dropped because of their dimensions
+
+    private:
+        std::vector< Slot > slots;
+        unsigned int slotRows, slotColumns;
+        bool useEightBit;
+
+        std::atomic<bool> enabled;
+        std::atomic<unsigned int> inFlight;     // pipeline calls between the enabled check and their last slot access
+        std::atomic<unsigned long long> pushCount, overflowCount, mismatchCount;
+        const FrameStatistics* arrivalSource;
+
+        // written by the producer only / by the consumer only, kept on separate cache lines
+        alignas(64) std::atomic<size_t> head;
+        alignas(64) std::atomic<size_t> tail;
+
+        void push(const NITLibrary::NITFrame& frame);
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // FRAMERING_H_INCLUDED
@@ -0,0 +1,87 @@
+#ifndef FRAMESTATISTICS_H_INCLUDED
+#define FRAMESTATISTICS_H_INCLUDED
+
+#include <NITFilter.h>
+#include <NITFrame.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+/** Pass-through filter at the head of the pipeline that keeps stream statistics            **/
+/**                                                                                           **/
+/** Frames are not modified. A jump in NITFrame::Id() counts as a gap with the skipped Ids   **/
+/** as missing frames, an Id that doesn't increase counts as a reset. The host arrival       **/
+/** intervals give mean, standard deviation (jitter), min and max, updated with Welford's     **/
+/** method. The pipeline thread is the only writer: snapshot() copies the counters without a **/
+/** lock and retries if a frame was counted meanwhile, so it can be polled at any rate.      **/
+/** The host time each frame entered the pipeline is kept by Id for the last ARRIVAL_HISTORY **/
+/** frames: the sinks further down look it up instead of timing the frame themselves, which  **/
+/** would add the work of the filters in between.                                            **/
+class FrameStatistics : public NITLibrary::NITFilter
+{
+    public:
+        struct Snapshot
+        {
+            Snapshot() : frames(0), gaps(0), missingFrames(0), largestGap(0), idResets(0), lastId(0),
+                         meanInterval(0.0), jitter(0.0), minInterval(0.0), maxInterval(0.0) {}
+            unsigned long long frames;          //!< Frames that reached the pipeline
+            unsigned long long gaps;            //!< Jumps in NITFrame::Id()
+            unsigned long long missingFrames;   //!< Ids skipped by all gaps
+            unsigned long long largestGap;      //!< Most Ids skipped by one gap
+            unsigned long long idResets;        //!< Ids lower than or equal to the one before
+            unsigned long long lastId;          //!< Id of the last frame
+            double meanInterval;                //!< Mean time between two frames in ms
+            double jitter;                      //!< Standard deviation of the intervals in ms
+            double minInterval, maxInterval;    //!< Shortest and longest interval in ms
+        };
+
+        FrameStatistics();
+        ~FrameStatistics();
+
+        /** Consistent copy of the counters **/
+        Snapshot snapshot() const;
+        /** Count from zero again, a snapshot taken before the next frame is empty **/
+        void reset();
+        /** The next frame starts a new stream: no gap and no interval to the frame before     **/
+        /** Call it when the device is started, the frames between two captures are not sent **/
+        void restartStream();
+
+        static const unsigned int ARRIVAL_HISTORY = 4096;
+
+        /** Host time at which the frame with this Id entered the pipeline                **/
+        /** Return false if it isn't one of the last ARRIVAL_HISTORY frames. Thread safe. **/
+        bool arrivalTime(unsigned long long id, std::chrono::steady_clock::time_point& time) const;
+
+    private:
+        std::atomic<unsigned int> sequence;     // odd while the pipeline thread updates the counters
+        std::atomic<bool> resetPending, restartPending;
+
+        // written by the pipeline thread only
+        std::atomic<unsigned long long> frameCount, gapCount, missingCount, largestGapSize, resetCount, lastFrameId;
+        std::atomic<unsigned long long> intervalCount;
+        std::atomic<double> intervalMean, intervalM2, intervalMin, intervalMax;
+
+        // owned by the pipeline thread
+        bool streaming;
+        std::chrono::steady_clock::time_point lastArrival;
+
+        struct Arrival
+        {
+            Arrival() : id(0), valid(false) {}
+            unsigned long long id;
+            std::chrono::steady_clock::time_point time;
+            bool valid;
+        };
+        // indexed by Id modulo ARRIVAL_HISTORY, read by the sinks of other threads
+        mutable std::mutex arrivalMutex;
+        std::vector< Arrival > arrivals;
+
+        void clear();
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(NITLibrary::NITFrame& frame);
+};
+
+#endif // FRAMESTATISTICS_H_INCLUDED
@@ -0,0 +1,43 @@
+#ifndef FRAMETRANSFORM_H_INCLUDED
+#define FRAMETRANSFORM_H_INCLUDED
+
+#include <atomic>
+
+#include "FrameRelay.h"
+
+/** Flip, rotation and transpose of the frames in the stream                               **/
+/**                                                                                         **/
+/** Rotations by 90/270 degrees and the transpose swap rows and columns, so the frame that  **/
+/** goes on is a copy with its own dimensions and the relay can't be an in place filter.    **/
+/** Every copy gets a buffer of its own from the FrameRelay ring.                           **/
+/** TRANSPOSE hands on columns x rows frames in row major order, which is the column major  **/
+/** layout MATLAB expects: reshape(data, rows, columns) gives the image without a transpose.**/
+/** The transposing modes walk the frame in 32 x 32 tiles (source and destination tile stay **/
+/** in L1) and transpose 8 x 8 (AVX2) or 4 x 4 (SSE4.1) blocks in registers, the flips copy **/
+/** or reverse whole rows. NONE forwards the frame itself, without a copy.                  **/
+class FrameTransform : public FrameRelay
+{
+    public:
+        /** ROTATE_90 / ROTATE_270 turn the image clockwise / counterclockwise **/
+        enum eTransform { NONE, FLIP_HORIZONTAL, FLIP_VERTICAL, ROTATE_180, TRANSPOSE, ROTATE_90, ROTATE_270 };
+
+        FrameTransform();
+        ~FrameTransform();
+
+        void setTransform(eTransform transform) { transformMode.store(transform); }
+        eTransform transform() const            { return (eTransform)transformMode.load(); }
+
+        /** Dimensions of the frames handed on for rows x columns input frames **/
+        void outputSize(unsigned int rows, unsigned int columns, unsigned int& out_rows, unsigned int& out_columns) const;
+
+        /** Transform one rows x columns frame (row major) into dst, which must not overlap src **/
+        static void apply(eTransform transform, const float* src, unsigned int rows, unsigned int columns, float* dst);
+
+    private:
+        std::atomic<int> transformMode;
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // FRAMETRANSFORM_H_INCLUDED
@@ -0,0 +1,28 @@
+#ifndef GAINKERNELS_H_INCLUDED
+#define GAINKERNELS_H_INCLUDED
+
+#include <cstddef>
+
+/** Linear gain kernels: out = clamp(round(in * scale + offset), 0, 255)                       **/
+/** Used by the gain control filters. An AVX2 or SSE4.1 kernel is picked at runtime, with a    **/
+/** scalar fallback giving the same results (round half to even).                               **/
+
+/** In place on the float pixels of a NITFrame, the result holds whole values 0..255 **/
+void gainFloat(float* pixels, size_t count, float scale, float offset);
+/** Float pixels to a separate 8-bit buffer **/
+void gainToUint8(const float* src, unsigned char* dst, size_t count, float scale, float offset);
+/** Raw 14-bit pixels to a separate 8-bit buffer **/
+void gainToUint8(const unsigned short* src, unsigned char* dst, size_t count, float scale, float offset);
+
+/** Per-pixel linear correction in place: pixels[i] = pixels[i] * gain[i] + offset[i]        **/
+/** (fused multiply-add when the CPU has FMA, so the last bit can differ from the fallback) **/
+void applyGainOffset(float* pixels, const float* gain, const float* offset, size_t count);
+
+/** Dark frame subtraction in place: pixels[i] = max(pixels[i] - dark[i], 0) **/
+void subtractClamp(float* pixels, const float* dark, size_t count);
+
+/** Add count pixels taken every step pixels to a 16384 bin histogram (14-bit levels,     **/
+/** values outside 0..16383 go to the first / last bin)                                   **/
+void accumulateHistogram14(const float* src, size_t count, size_t step, unsigned int* bins);
+
+#endif // GAINKERNELS_H_INCLUDED
@@ -0,0 +1,38 @@
+#ifndef METADATAFORMAT_H_INCLUDED
+#define METADATAFORMAT_H_INCLUDED
+
+#include <cstdint>
+
+/** Layout of the .meta sidecar files written by FrameMetadataTable (little endian)          **/
+/**                                                                                          **/
+/**    0                 MetadataHeader, padded to METADATA_HEADER_SIZE bytes                 **/
+/**    headerSize        one column after the other, frameCount values each:                  **/
+/**                      id            uint64   NITFrame::Id()                                **/
+/**                      hostTime      double   entry into the pipeline, seconds on the       **/
+/**                                               monotonic host clock                          **/
+/**                      temperature   float    NITFrame::temperature()                       **/
+/**                      timestamp     double   NITFrame::gigeTimestamp()                     **/
+/**                      exposureTime  double   requested exposure time in us                 **/
+/**                      triggerDelay  double   requested trigger delay in us                 **/
+/**                      gatedMode     uint8    1 gated, 0 global shutter                     **/
+/** Columns are read in one fread each, see readNITMetadata.m.                               **/
+
+static const char METADATA_MAGIC[8] = { 'N', 'I', 'T', 'M', 'E', 'T', 'A', 0 };
+static const uint32_t METADATA_VERSION = 1;
+static const uint32_t METADATA_HEADER_SIZE = 64;
+static const uint32_t METADATA_COLUMN_COUNT = 7;
+
+#pragma pack(push, 1)
+struct MetadataHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t columnCount;
+    uint32_t reserved;
+    uint64_t frameCount;
+    uint64_t overflows;         // frames that didn't fit into the table
+};
+#pragma pack(pop)
+
+#endif // METADATAFORMAT_H_INCLUDED
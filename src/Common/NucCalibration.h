@@ -0,0 +1,59 @@
+#ifndef NUCCALIBRATION_H_INCLUDED
+#define NUCCALIBRATION_H_INCLUDED
+
+#include <vector>
+#include <map>
+#include <string>
+
+/** Two point NUC computed from a low and a high flat field per exposure time and mode      **/
+/**                                                                                         **/
+/** For each pixel: gain = (high - low) of the frame / (high - low) of the pixel and          **/
+/** offset = low of the frame - gain * low of the pixel, the frame values being the means of  **/
+/** the good pixels. A pixel is bad if its response (high - low) is off the median response   **/
+/** by more than max_response_deviation, or if its temporal noise is above noise_factor times   **/
+/** the median noise; bad pixels get gain 1, offset 0 and are replaced by the NucTable.         **/
+class NucCalibration
+{
+    public:
+        struct Result
+        {
+            unsigned int rows, columns;
+            std::vector< float > gain, offset;
+            std::vector< unsigned char > badPixels;
+            size_t badPixelCount;
+        };
+
+        NucCalibration();
+
+        void clear()    { points.clear(); }
+
+        /** Store the low or high flat field of exposure_time and mode (mean and temporal standard deviation per pixel) **/
+        void setPoint(double exposure_time, int mode, bool high, unsigned int rows, unsigned int columns,
+                      const std::vector< float >& mean, const std::vector< float >& stddev);
+
+        /** Exposure times and modes with both points, in increasing order **/
+        void completePoints(std::vector< double >& exposure_times, std::vector< int >& modes) const;
+
+        /** Compute the NUC of a complete point, false if a point is missing or has another size **/
+        bool compute(double exposure_time, int mode, Result& result) const;
+
+        float maxResponseDeviation;     // default 0.5: the response must be within 50% of the median
+        float noiseFactor;              // default 5
+
+    private:
+        struct FlatField
+        {
+            FlatField() : rows(0), columns(0) {}
+            unsigned int rows, columns;
+            std::vector< float > mean, stddev;
+        };
+        struct Point
+        {
+            FlatField low, high;
+        };
+
+        typedef std::pair< int, double > PointKey;      // mode, exposure time
+        std::map< PointKey, Point > points;
+};
+
+#endif // NUCCALIBRATION_H_INCLUDED
@@ -0,0 +1,42 @@
+#ifndef NUCFILE_H_INCLUDED
+#define NUCFILE_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "NucTable.h"
+
+/** Reading the .yml NUC files into NucTables                                                 **/
+/**                                                                                           **/
+/** The files are OpenCV FileStorage YAML. Every !!opencv-matrix whose name contains "gain",  **/
+/** "offset" or "bad"/"bpr" becomes the gain, offset or bad pixel map of the table (a missing **/
+/** gain is 1, a missing offset 0). Exposure time (us) and mode come from the scalar keys      **/
+/** containing "expo" and "mode", else from the file name: NUCFactory_0.2us.yml,              **/
+/** NUCFactory_Gated_200ns.yml.                                                                **/
+/** This is the layout writeNucFile() produces. The SDK's own NUC files are not documented to  **/
+/** follow it: hand those to NITDevice::setNucDirectory, not to readNucFile().                 **/
+
+/** Where a NUC file belongs **/
+struct NucFileInfo
+{
+    NucFileInfo() : exposureTime(-1.0), mode(-1) {}
+    std::string path;
+    double exposureTime;    // us, < 0 if unknown
+    int mode;               // NucMode
+};
+
+/** The .yml files of directory, or of its NUC subdirectory like NITDevice::setNucDirectory **/
+std::vector< std::string > listNucFiles(const std::string& directory);
+
+/** Parse a NUC file, NULL if it holds no usable matrix (info is filled in any case) **/
+std::shared_ptr<NucTable> readNucFile(const std::string& path, NucFileInfo& info);
+
+/** Write a NUC file readNucFile() reads back, bad_pixels may be NULL **/
+bool writeNucFile(const NucFileInfo& info, unsigned int rows, unsigned int columns,
+                  const float* gain, const float* offset, const unsigned char* bad_pixels);
+
+/** NUCFactory_<mode>_<exposure>us.yml **/
+std::string nucFileName(double exposure_time, int mode);
+
+#endif // NUCFILE_H_INCLUDED
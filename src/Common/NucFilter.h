@@ -0,0 +1,67 @@
+#ifndef NUCFILTER_H_INCLUDED
+#define NUCFILTER_H_INCLUDED
+
+#include <NITFilter.h>
+#include <NITFrame.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include "NucTable.h"
+
+/** Sensor mode a NucTable was made for **/
+enum NucMode
+{
+    NUC_ANY_MODE = -1,
+    NUC_GLOBAL_SHUTTER = 0,
+    NUC_GATED = 1
+};
+
+/** Software NUC and bad pixel replacement with one in-memory NucTable per exposure and mode **/
+/**                                                                                         **/
+/** selectExposure() only swaps a pointer: the streaming thread picks up the new table with **/
+/** the next frame, nothing is read from disk. A table in use stays alive until the frame    **/
+/** that uses it is done, even if it is replaced or cleared meanwhile.                       **/
+/** A table stored for NUC_ANY_MODE is used when there is none for the exact mode.           **/
+/** Without a table for the selected exposure, or with a frame of another size, the frames   **/
+/** pass through uncorrected.                                                                 **/
+class NucFilter : public NITLibrary::NITFilter
+{
+    public:
+        NucFilter();
+        ~NucFilter();
+
+        /** Store the table of exposure_time and mode, replacing an older one **/
+        void addTable(double exposure_time, const std::shared_ptr<const NucTable>& table, int mode = NUC_ANY_MODE);
+        bool hasTable(double exposure_time, int mode = NUC_ANY_MODE) const;
+        size_t tableCount() const;
+        void clearTables();
+
+        /** Correct the next frames with the table of exposure_time and mode, false if there is none **/
+        bool selectExposure(double exposure_time, int mode = NUC_ANY_MODE);
+        /** Table applied to the frames, NULL if none **/
+        std::shared_ptr<const NucTable> currentTable() const;
+
+        unsigned long long corrected() const    { return correctedCount.load(); }    //!< Frames corrected
+        unsigned long long mismatches() const   { return mismatchCount.load(); }     //!< Frames passed through because of their dimensions
+
+    private:
+        typedef std::pair< int, double > TableKey;      // mode, exposure time
+        typedef std::map< TableKey, std::shared_ptr<const NucTable> > TableMap;
+
+        mutable std::mutex tablesMutex;
+        TableMap tables;
+        std::shared_ptr<const NucTable> current;     // only accessed with std::atomic_load / atomic_store
+
+        std::atomic<unsigned long long> correctedCount, mismatchCount;
+
+        TableMap::const_iterator find(double exposure_time, int mode) const;
+        TableMap::const_iterator findForMode(double exposure_time, int mode) const;
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(NITLibrary::NITFrame& frame);
+};
+
+#endif // NUCFILTER_H_INCLUDED
@@ -0,0 +1,43 @@
+#ifndef NUCTABLE_H_INCLUDED
+#define NUCTABLE_H_INCLUDED
+
+#include <vector>
+#include <cstddef>
+
+/** Non uniformity correction of one exposure time, held in memory                          **/
+/**                                                                                         **/
+/** corrected = raw * gain + offset per pixel, then every bad pixel is replaced by the mean  **/
+/** of its good neighbours. The neighbours are looked up once when the table is built, the   **/
+/** frame path only walks a flat index list.                                                  **/
+class NucTable
+{
+    public:
+        /** gain and offset hold rows x columns values (row major)             **/
+        /** bad_pixels: rows x columns flags, non zero = bad, NULL = no bad pixel **/
+        NucTable(unsigned int rows, unsigned int columns, const float* gain, const float* offset, const unsigned char* bad_pixels);
+
+        unsigned int rows() const       { return tableRows; }
+        unsigned int columns() const    { return tableColumns; }
+        const float* gain() const       { return gainTable.data(); }
+        const float* offset() const     { return offsetTable.data(); }
+        size_t badPixels() const        { return replacements.size(); }
+
+        /** Apply gain, offset and bad pixel replacement in place on a rows x columns frame **/
+        void apply(float* pixels) const;
+
+    private:
+        struct Replacement
+        {
+            unsigned int index;         // bad pixel
+            unsigned int first, count;  // its good neighbours in neighbourList, count 0 = left as is
+        };
+
+        unsigned int tableRows, tableColumns;
+        std::vector< float > gainTable, offsetTable;
+        std::vector< Replacement > replacements;
+        std::vector< unsigned int > neighbourList;
+
+        void findNeighbours(const unsigned char* bad_pixels);
+};
+
+#endif // NUCTABLE_H_INCLUDED
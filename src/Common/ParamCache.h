@@ -0,0 +1,69 @@
+#ifndef PARAMCACHE_H_INCLUDED
+#define PARAMCACHE_H_INCLUDED
+
+#include <string>
+#include <map>
+#include <mutex>
+
+/** Shadow copy of the device parameters                                                     **/
+/** It is fed by the NITConfigObserver callbacks and answers whether writing a value to the    **/
+/** device would change anything, so callers can skip setParamValueOf/updateConfig round trips. **/
+/**                                                                                            **/
+/** Some values are adapted by the device (e.g. exposure time steps). When a requested value   **/
+/** ends up as another value, the request is remembered so asking for it again is a no-op too. **/
+class ParamCache
+{
+    public:
+        ParamCache();
+        ~ParamCache();
+
+        /** Parameter names are compared without case, spaces and underscores **/
+        /** "Exposure Time", "ExposureTime" and "EXPOSURETIME" are the same    **/
+        static std::string key(const std::string& param_name);
+
+        /** Called from the config observer with the current value of a parameter **/
+        void update(const char* param_name, const char* str_value, float num_value);
+
+        /** Return true if the device already holds this value, or adapted it from the same request **/
+        bool matches(const std::string& param_name, const std::string& value);
+        bool matches(const std::string& param_name, double value);
+
+        /** Remember a value written with setParamValueOf **/
+        void request(const std::string& param_name, const std::string& value);
+        void request(const std::string& param_name, double value);
+
+        /** Called after updateConfig: requests without a change notification were adapted to the current value **/
+        void settle();
+        /** Called when updateConfig failed: the device state of the requested parameters is unknown **/
+        /** until it reports them again, so they match nothing                                       **/
+        void invalidatePending();
+
+        /** Return false if the parameter was never reported by the device **/
+        bool lookup(const std::string& param_name, std::string& str_value, float& num_value);
+
+    private:
+        struct Value
+        {
+            Value() : valid(false), numeric(false), num(0.0) {}
+            bool valid, numeric;
+            std::string str;
+            double num;
+        };
+        struct Entry
+        {
+            Entry() : numValue(0.0f) {}
+            std::string strValue;
+            float numValue;
+            Value pending;   // written but not yet confirmed by the device
+            Value alias;     // request the device turned into the current value
+        };
+
+        std::mutex cacheMutex;
+        std::map< std::string, Entry > entries;
+
+        static bool sameString(const std::string& a, const std::string& b);
+        static bool sameNumber(double a, double b);
+        static bool holds(const Entry& entry, const Value& value);
+};
+
+#endif // PARAMCACHE_H_INCLUDED
@@ -0,0 +1,24 @@
+#ifndef PIXELCONVERT_H_INCLUDED
+#define PIXELCONVERT_H_INCLUDED
+
+#include <cstddef>
+
+/** Conversion of the float pixels of NITFrame to packed integer pixels                       **/
+/** Values are multiplied by scale, rounded to nearest and saturated to the range of the type.  **/
+/** An AVX2 or SSE4.1 kernel is picked at runtime, with a scalar fallback for older CPUs.       **/
+
+/** 14-bit frames: float -> unsigned short, half the size of the float frame **/
+void packUint16(const float* src, unsigned short* dst, size_t count, float scale = 1.0f);
+/** Gain controlled frames: float -> unsigned char, a quarter of the size of the float frame **/
+void packUint8(const float* src, unsigned char* dst, size_t count, float scale = 1.0f);
+/** Float copy with the same scale, no rounding **/
+void packFloat(const float* src, float* dst, size_t count, float scale = 1.0f);
+
+/** Same conversions of one rows x columns frame, written column major (MATLAB layout):    **/
+/** dst[c * rows + r] = convert(src[r * columns + c] * scale). Conversion and transpose run  **/
+/** in one cache blocked pass over the frame.                                                 **/
+void packUint16ColumnMajor(const float* src, unsigned short* dst, unsigned int rows, unsigned int columns, float scale = 1.0f);
+void packUint8ColumnMajor(const float* src, unsigned char* dst, unsigned int rows, unsigned int columns, float scale = 1.0f);
+void packFloatColumnMajor(const float* src, float* dst, unsigned int rows, unsigned int columns, float scale = 1.0f);
+
+#endif // PIXELCONVERT_H_INCLUDED
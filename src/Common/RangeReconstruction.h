@@ -0,0 +1,65 @@
+#ifndef RANGERECONSTRUCTION_H_INCLUDED
+#define RANGERECONSTRUCTION_H_INCLUDED
+
+#include <vector>
+
+#include "WorkerPool.h"
+
+/** Per-pixel range from a gated trigger delay stack                                        **/
+/**                                                                                          **/
+/** The stack is steps x rows x columns (as filled by NITCam::captureDelaySweep) with the     **/
+/** trigger delay of each step in microseconds. For every pixel the step with the highest    **/
+/** intensity is searched, then refined between the steps:                                   **/
+/**    PEAK      delay of the brightest step                                                 **/
+/**    CENTROID  intensity weighted mean delay of the steps around the peak                  **/
+/**    PARABOLIC vertex of the parabola through the peak and its two neighbours              **/
+/** The range is the round trip delay converted to metres.                                   **/
+class RangeReconstruction
+{
+    public:
+        enum eMethod { PEAK, CENTROID, PARABOLIC };
+
+        RangeReconstruction();
+        ~RangeReconstruction();
+
+        /** Pixels whose peak is below min_intensity get NaN as range and delay **/
+        void setMinIntensity(float min_intensity)  { minIntensity = min_intensity; }
+        /** Number of steps on each side of the peak used by CENTROID (default 2) **/
+        void setCentroidHalfWidth(unsigned int half_width) { centroidHalfWidth = half_width; }
+
+        bool compute(const unsigned short* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                     const double* delays, eMethod method);
+        bool compute(const unsigned char* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                     const double* delays, eMethod method);
+        bool compute(const float* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                     const double* delays, eMethod method);
+
+        unsigned int rows() const       { return mapRows; }
+        unsigned int columns() const    { return mapColumns; }
+
+        const float* range() const              { return rangeMap.data(); }     //!< metres, rows x columns
+        const float* delay() const              { return delayMap.data(); }     //!< microseconds, rows x columns
+        const float* intensity() const          { return intensityMap.data(); } //!< peak intensity, rows x columns
+        const unsigned short* peakIndex() const { return peakMap.data(); }      //!< brightest step, rows x columns
+
+    private:
+        WorkerPool pool;
+
+        float minIntensity;
+        unsigned int centroidHalfWidth;
+        unsigned int mapRows, mapColumns;
+
+        std::vector< float > rangeMap, delayMap, intensityMap;
+        std::vector< unsigned short > peakMap;
+        std::vector< float > stepDelays;
+
+        template< typename T >
+        bool computeStack(const T* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                          const double* delays, eMethod method);
+        template< typename T >
+        void computeBand(const T* stack, unsigned int steps, size_t frame_size, eMethod method, size_t begin, size_t end);
+
+        float delayAt(unsigned short index, float offset) const;
+};
+
+#endif // RANGERECONSTRUCTION_H_INCLUDED
@@ -0,0 +1,53 @@
+#ifndef SDKDEVICE_H_INCLUDED
+#define SDKDEVICE_H_INCLUDED
+
+#include "CameraDevice.h"
+
+/** CameraDevice of a camera opened by the NITManager, every call goes to the NITDevice **/
+/** The NITDevice belongs to the NITManager: ReleaseDevice() releases it there.         **/
+class SdkDevice : public CameraDevice
+{
+    public:
+        explicit SdkDevice(NITLibrary::NITDevice* device) : dev(device) {}
+
+        NITLibrary::NITDevice* device() const                      { return dev; }
+
+        unsigned int sensorWidth() const                            { return dev->sensorWidth(); }
+        unsigned int sensorHeight() const                           { return dev->sensorHeight(); }
+        NITLibrary::ConnectorType connectorType() const             { return dev->connectorType(); }
+        std::string commercialName() const                          { return dev->commercialName(); }
+        std::string serialNumber() const                            { return dev->serialNumber(); }
+
+        void activateNuc(bool activate = true)                      { dev->activateNuc(activate); }
+        void activateBpr(bool activate = true)                      { dev->activateBpr(activate); }
+        bool nucActive() const                                      { return dev->nucActive(); }
+        bool bprActive() const                                      { return dev->bprActive(); }
+        void setNucDirectory(const std::string& dir_path, bool is_bpr_path = true) { dev->setNucDirectory(dir_path, is_bpr_path); }
+        void setNucFile(const std::string& file_path)               { dev->setNucFile(file_path); }
+        void setBprFile(const std::string& file_path)               { dev->setBprFile(file_path); }
+
+        void setFps(double new_fps)                                 { dev->setFps(new_fps); }
+        double fps() const                                          { return dev->fps(); }
+        double minFps() const                                       { return dev->minFps(); }
+        double maxFps() const                                       { return dev->maxFps(); }
+
+        double paramValueOf(const std::string& param_name) const    { return dev->paramValueOf(param_name); }
+        std::string paramStrValueOf(const std::string& param_name) const { return dev->paramStrValueOf(param_name); }
+        CameraDevice& setParamValueOf(const std::string& param_name, unsigned int value)        { dev->setParamValueOf(param_name, value); return *this; }
+        CameraDevice& setParamValueOf(const std::string& param_name, double value)              { dev->setParamValueOf(param_name, value); return *this; }
+        CameraDevice& setParamValueOf(const std::string& param_name, const std::string& value)  { dev->setParamValueOf(param_name, value); return *this; }
+        void updateConfig()                                         { dev->updateConfig(); }
+
+        void start()                                                { dev->start(); }
+        void captureNFrames(size_t n, bool error_increment_count = false) { dev->captureNFrames(n, error_increment_count); }
+        void stop()                                                 { dev->stop(); }
+        bool waitEndCapture(int timeout = -1)                       { return dev->waitEndCapture(timeout); }
+
+        NITLibrary::NITFilter& operator<<(NITLibrary::NITFilter& filter)    { return *dev << filter; }
+        void operator<<(NITLibrary::NITConfigObserver& observer)            { *dev << observer; }
+
+    private:
+        NITLibrary::NITDevice* dev;
+};
+
+#endif // SDKDEVICE_H_INCLUDED
@@ -0,0 +1,45 @@
+#ifndef SEQUENCEFORMAT_H_INCLUDED
+#define SEQUENCEFORMAT_H_INCLUDED
+
+#include <cstdint>
+
+/** Layout of the .seq files written by SequenceRecorder (little endian)                    **/
+/**                                                                                          **/
+/**    0                 SequenceHeader, padded to SEQUENCE_HEADER_SIZE bytes                 **/
+/**    dataOffset        frameCount frames of frameBytes each, rows x columns row major,      **/
+/**                      unsigned short (bitDepth 16) or unsigned char (bitDepth 8)           **/
+/**    indexOffset       frameCount SequenceIndexEntry, one per frame in file order           **/
+/** A file with frameCount 0 was not closed properly, the frames are there but not the index.**/
+/** Its frame count is recovered from the file size: the frames that fit between dataOffset  **/
+/** and the end of the file, or indexOffset (the reserved index) if that comes first.        **/
+
+static const char SEQUENCE_MAGIC[8] = { 'N', 'I', 'T', 'S', 'E', 'Q', 0, 0 };
+static const uint32_t SEQUENCE_VERSION = 1;
+static const uint32_t SEQUENCE_HEADER_SIZE = 4096;
+
+#pragma pack(push, 1)
+struct SequenceHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t width;             // columns
+    uint32_t height;            // rows
+    uint32_t bitDepth;          // 16 or 8
+    uint32_t indexEntrySize;    // sizeof(SequenceIndexEntry)
+    uint64_t frameCount;
+    uint64_t frameBytes;
+    uint64_t dataOffset;
+    uint64_t indexOffset;
+};
+
+struct SequenceIndexEntry
+{
+    uint64_t id;                // NITFrame::Id()
+    float temperature;          // NITFrame::temperature()
+    uint32_t reserved;
+    double timestamp;           // NITFrame::gigeTimestamp()
+};
+#pragma pack(pop)
+
+#endif // SEQUENCEFORMAT_H_INCLUDED
@@ -0,0 +1,70 @@
+#ifndef SEQUENCEREADER_H_INCLUDED
+#define SEQUENCEREADER_H_INCLUDED
+
+#include <Windows.h>
+
+#include <string>
+
+#include "SequenceFormat.h"
+
+/** Random access to a sequence file written by SequenceRecorder                              **/
+/**                                                                                            **/
+/** The whole file is mapped read only, nothing is read until a frame is touched.              **/
+/** frame16 / frame8 / frames16 / frames8 return views into the mapping (no copy), valid until  **/
+/** close(). readFrames16 / readFrames8 gather a strided subset of frames and a pixel ROI into  **/
+/** the caller's buffer with one copy, laid out as frames x roiRows x roiColumns (row major).   **/
+/** Frame numbers start at 0.                                                                   **/
+/** A file that was not closed is opened with the frames that fit before its reserved index,    **/
+/** frameId / frameTemperature / frameTimestamp return 0 for them.                              **/
+class SequenceReader
+{
+    public:
+        SequenceReader();
+        ~SequenceReader();
+
+        bool open(const std::string& fileName);
+        void close();
+        bool isOpen() const                     { return header != NULL; }
+
+        unsigned int width() const              { return header != NULL ? header->width : 0; }
+        unsigned int height() const             { return header != NULL ? header->height : 0; }
+        unsigned int bitDepth() const           { return header != NULL ? header->bitDepth : 0; }
+        unsigned long long frameCount() const   { return frames; }
+
+        /** View of one frame, numel must be height() * width() **/
+        const unsigned short* frame16(unsigned long long frame, size_t numel) const;
+        const unsigned char* frame8(unsigned long long frame, size_t numel) const;
+        /** View of count consecutive frames, numel must be count * height() * width() **/
+        const unsigned short* frames16(unsigned long long first, unsigned long long count, size_t numel) const;
+        const unsigned char* frames8(unsigned long long first, unsigned long long count, size_t numel) const;
+
+        /** Copy frames first, first + stride, ... (count frames) cropped to the ROI into data **/
+        /** numel must be count * roiRows * roiColumns                                          **/
+        bool readFrames16(unsigned long long first, unsigned long long count, unsigned long long stride,
+                          unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns,
+                          unsigned short* data, size_t numel) const;
+        bool readFrames8(unsigned long long first, unsigned long long count, unsigned long long stride,
+                         unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns,
+                         unsigned char* data, size_t numel) const;
+
+        unsigned long long frameId(unsigned long long frame) const;
+        float frameTemperature(unsigned long long frame) const;
+        double frameTimestamp(unsigned long long frame) const;
+
+    private:
+        HANDLE file;
+        HANDLE mapping;
+        const unsigned char* view;
+        unsigned long long fileSize;
+        unsigned long long frames;          // header->frameCount, or recovered from the file size
+        const SequenceHeader* header;
+        const SequenceIndexEntry* index;
+
+        const unsigned char* pixels(unsigned long long first, unsigned long long count, size_t numel, unsigned int bit_depth) const;
+        template< typename T >
+        bool gather(unsigned long long first, unsigned long long count, unsigned long long stride,
+                    unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns,
+                    T* data, size_t numel) const;
+};
+
+#endif // SEQUENCEREADER_H_INCLUDED
@@ -0,0 +1,83 @@
+#ifndef SEQUENCERECORDER_H_INCLUDED
+#define SEQUENCERECORDER_H_INCLUDED
+
+#include <Windows.h>
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "SequenceFormat.h"
+
+/** This observer records frames into one preallocated sequence file (see SequenceFormat.h)   **/
+/**                                                                                           **/
+/** The file is sized for all frames when it is opened. The pipeline thread packs each frame  **/
+/** into a chunk of several frames, full chunks are written by a background thread with one   **/
+/** large write per chunk. If the disk falls behind and no chunk is free the frame is dropped  **/
+/** and counted in droppedFrames(), the pipeline never waits for the disk.                     **/
+/** close() flushes the last chunk, appends the frame index and fixes up the header.           **/
+class SequenceRecorder : public NITLibrary::NITObserver
+{
+    public:
+        SequenceRecorder();
+        ~SequenceRecorder();
+
+        /** Create file_name for frame_count frames of rows x columns pixels and start recording **/
+        bool open(const std::string& file_name, unsigned int frame_count, unsigned int rows, unsigned int columns, bool eight_bit);
+        /** Stop recording and finish the file, returns false if a write failed **/
+        bool close();
+        bool isOpen() const                 { return file != INVALID_HANDLE_VALUE; }
+        const std::string& fileName() const { return path; }
+
+        unsigned int frames();          //!< Number of frames recorded since open()
+        unsigned int droppedFrames();   //!< Frames rejected because of their dimensions or because the writer was behind
+        /** Block until count frames were recorded or dropped, false if deadline passed first **/
+        bool waitForFrames(unsigned int count, const std::chrono::steady_clock::time_point& deadline);
+
+    private:
+        struct Chunk
+        {
+            std::vector< unsigned char > data;
+            unsigned int frames;
+        };
+
+        std::string path;
+        HANDLE file;
+        SequenceHeader header;
+        size_t chunkBytes;
+        unsigned int framesPerChunk;
+
+        // pipeline side, guarded by recordMutex
+        std::mutex recordMutex;
+        std::condition_variable frameCondition;     // signalled for every frame, see waitForFrames
+        bool armed;
+        unsigned int capacity, recorded, dropped;
+        int current;                    // chunk being filled, -1 if none is free
+        std::vector< SequenceIndexEntry > index;
+
+        // shared with the writer thread, guarded by queueMutex
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::vector< Chunk > chunks;
+        std::deque< int > freeChunks, fullChunks;
+        unsigned long long framesWritten;
+        bool writeFailed;
+        bool stopWriter;
+        std::thread writer;
+
+        void writeLoop();
+        bool writeAt(unsigned long long offset, const void* data, size_t bytes);
+        void releaseFile();
+        void record(const NITLibrary::NITFrame& frame);
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // SEQUENCERECORDER_H_INCLUDED
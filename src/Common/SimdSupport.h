@@ -0,0 +1,77 @@
+#ifndef SIMDSUPPORT_H_INCLUDED
+#define SIMDSUPPORT_H_INCLUDED
+
+/** Runtime detection of the instruction sets used by the pixel kernels                     **/
+/** The kernels are compiled for every instruction set (MSVC doesn't need /arch for          **/
+/** intrinsics, gcc/clang get a target attribute) and one is picked when the CPU supports it. **/
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define SIMD_TARGET_AVX2
+    #define SIMD_TARGET_SSE41
+    #define SIMD_TARGET_FMA
+#else
+    #include <cpuid.h>
+    #define SIMD_TARGET_AVX2  __attribute__((target("avx2")))
+    #define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+    #define SIMD_TARGET_FMA   __attribute__((target("avx2,fma")))
+#endif
+
+#include <immintrin.h>
+
+inline void simdCpuid(int info[4], int leaf, int subleaf)
+{
+#if defined(_MSC_VER)
+    __cpuidex(info, leaf, subleaf);
+#else
+    unsigned int a, b, c, d;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    info[0] = (int)a; info[1] = (int)b; info[2] = (int)c; info[3] = (int)d;
+#endif
+}
+
+/** True if the OS saves the AVX registers on context switches **/
+inline bool simdOsSupportsAvx()
+{
+    int info[4];
+    simdCpuid(info, 1, 0);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if( !osxsave || !avx )
+        return false;
+#if defined(_MSC_VER)
+    unsigned long long xcr0 = _xgetbv(0);
+#else
+    unsigned int lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    unsigned long long xcr0 = ((unsigned long long)hi << 32) | lo;
+#endif
+    return (xcr0 & 0x6) == 0x6;
+}
+
+inline bool simdHasSse41()
+{
+    int info[4];
+    simdCpuid(info, 1, 0);
+    return (info[2] & (1 << 19)) != 0;
+}
+
+inline bool simdHasAvx2()
+{
+    if( !simdOsSupportsAvx() )
+        return false;
+    int info[4];
+    simdCpuid(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+inline bool simdHasFma()
+{
+    if( !simdHasAvx2() )
+        return false;
+    int info[4];
+    simdCpuid(info, 1, 0);
+    return (info[2] & (1 << 12)) != 0;
+}
+
+#endif // SIMDSUPPORT_H_INCLUDED
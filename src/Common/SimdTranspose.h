@@ -0,0 +1,50 @@
+#ifndef SIMDTRANSPOSE_H_INCLUDED
+#define SIMDTRANSPOSE_H_INCLUDED
+
+#include <cstddef>
+
+#include "SimdSupport.h"
+
+/** Register transposes of small float blocks for the tiled frame kernels                  **/
+/** The block is read from stride-spaced rows, v[k] receives column k of the block.         **/
+
+SIMD_TARGET_SSE41 inline void simdTranspose4x4(const float* src, size_t stride, __m128 v[4])
+{
+    __m128 v0 = _mm_loadu_ps(src);
+    __m128 v1 = _mm_loadu_ps(src + stride);
+    __m128 v2 = _mm_loadu_ps(src + 2 * stride);
+    __m128 v3 = _mm_loadu_ps(src + 3 * stride);
+    _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+    v[0] = v0;
+    v[1] = v1;
+    v[2] = v2;
+    v[3] = v3;
+}
+
+SIMD_TARGET_AVX2 inline void simdTranspose8x8(const float* src, size_t stride, __m256 v[8])
+{
+    __m256 t[8], u[8];
+    for( int k = 0; k < 8; ++k )
+        t[k] = _mm256_loadu_ps(src + k * stride);
+
+    // pairs of rows interleaved, then quads, then the 128-bit halves swapped
+    for( int k = 0; k < 8; k += 2 )
+    {
+        u[k] = _mm256_unpacklo_ps(t[k], t[k + 1]);
+        u[k + 1] = _mm256_unpackhi_ps(t[k], t[k + 1]);
+    }
+    for( int k = 0; k < 8; k += 4 )
+    {
+        t[k] = _mm256_shuffle_ps(u[k], u[k + 2], 0x44);
+        t[k + 1] = _mm256_shuffle_ps(u[k], u[k + 2], 0xEE);
+        t[k + 2] = _mm256_shuffle_ps(u[k + 1], u[k + 3], 0x44);
+        t[k + 3] = _mm256_shuffle_ps(u[k + 1], u[k + 3], 0xEE);
+    }
+    for( int k = 0; k < 4; ++k )
+    {
+        v[k] = _mm256_permute2f128_ps(t[k], t[k + 4], 0x20);
+        v[k + 4] = _mm256_permute2f128_ps(t[k], t[k + 4], 0x31);
+    }
+}
+
+#endif // SIMDTRANSPOSE_H_INCLUDED
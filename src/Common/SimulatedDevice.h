@@ -0,0 +1,148 @@
+#ifndef SIMULATEDDEVICE_H_INCLUDED
+#define SIMULATEDDEVICE_H_INCLUDED
+
+#include "CameraDevice.h"
+
+#include <NITConnectable.h>
+#include <NITObserver.h>
+#include <NITFrame.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+class UsbConfigObserver;
+
+/** A CameraDevice without hardware, for benchmarks and tests of the NITCam pipeline           **/
+/**                                                                                             **/
+/** It follows the contract of the USB devices:                                                 **/
+/**  - setParamValueOf only stages values, updateConfig applies them (ranges and steps are       **/
+/**    enforced, adapted values are reported) and calls the NITConfigObserver callbacks.         **/
+/**    The callbacks are protected: the observer must be a UsbConfigObserver, which befriends    **/
+/**    the simulator.                                                                            **/
+/**  - start / captureNFrames / captureForDuration stream 14-bit frames at fps() from an         **/
+/**    internal thread, stop and waitEndCapture end the streaming.                               **/
+/**  - A frame that can't be sent in time because the pipeline is busy is dropped and reported   **/
+/**    to the config observer with a non zero status, like a camera with a full buffer.          **/
+/** Gated mode renders a range gated scene (a slanted wall with a disc in front of it) so        **/
+/** delay sweeps peak at the expected trigger delays, Global Shutter renders the same scene lit. **/
+/** Trigger Mode Input behaves like an external trigger running at fps(), common to all the     **/
+/** simulated cameras.                                                                           **/
+/** The frames enter the pipeline through Connectable::onNewImage(), with a NITFrame built on    **/
+/** the simulator's own buffer: the same SDK assumptions as FrameRelay. The simulator is only     **/
+/** built when CameraSelector.h selects SIMULATED_DEVICE, the connected filters and observers    **/
+/** are called in connection order from the streaming thread.                                    **/
+class SimulatedDevice : public CameraDevice
+{
+    public:
+        SimulatedDevice(unsigned int sensor_width, unsigned int sensor_height, double max_fps, const std::string& serial_number = "SIM0001");
+        ~SimulatedDevice();
+
+        unsigned int sensorWidth() const                    { return width; }
+        unsigned int sensorHeight() const                   { return height; }
+        NITLibrary::ConnectorType connectorType() const     { return NITLibrary::USB_3; }
+        std::string commercialName() const                  { return "Simulated NIT camera"; }
+        std::string serialNumber() const                    { return serial; }
+
+        void activateNuc(bool activate = true)  { nucOn = activate; }
+        void activateBpr(bool activate = true)  { bprOn = activate; }
+        bool nucActive() const                  { return nucOn; }
+        bool bprActive() const                  { return bprOn; }
+        void setNucDirectory(const std::string& dir_path, bool is_bpr_path = true);
+        void setNucFile(const std::string& file_path);
+        void setBprFile(const std::string& file_path);
+
+        void setFps(double new_fps);
+        double fps() const;
+        double minFps() const;
+        double maxFps() const;
+
+        void setRoi(unsigned int offset_x, unsigned int offset_y, unsigned int roi_width, unsigned int roi_height);
+
+        double paramValueOf(const std::string& param_name) const;
+        std::string paramStrValueOf(const std::string& param_name) const;
+        CameraDevice& setParamValueOf(const std::string& param_name, unsigned int value);
+        CameraDevice& setParamValueOf(const std::string& param_name, double value);
+        CameraDevice& setParamValueOf(const std::string& param_name, const std::string& value);
+        void updateConfig();
+
+        void start();
+        void captureNFrames(size_t n, bool error_increment_count = false);
+        void captureForDuration(unsigned long milliseconds);
+        void stop();
+        bool waitEndCapture(int timeout = -1);
+
+        NITLibrary::NITFilter& operator<<(NITLibrary::NITFilter& filter);
+        void operator<<(NITLibrary::NITObserver& observer);
+        void operator<<(NITLibrary::NITConfigObserver& observer);
+
+        /** Number of frames dropped because the pipeline didn't keep up **/
+        unsigned long long droppedFrames();
+
+    private:
+        struct Param
+        {
+            std::string name;
+            std::vector< std::string > choices;     // empty for numeric parameters
+            double minValue, maxValue, step;
+            double value;                           // index of the choice or numeric value
+        };
+
+        const unsigned int width, height;
+        const std::string serial;
+        const double sensorMaxFps;
+        bool nucOn, bprOn;
+        std::vector< Connectable* > downstream;     // connect before streaming starts
+        UsbConfigObserver* configObserver;
+
+        // parameters and scene, guarded by configMutex
+        mutable std::mutex configMutex;
+        std::map< std::string, Param > params;
+        std::vector< std::pair< std::string, double > > staged;    // values waiting for updateConfig
+        double currentFps, fpsMin, fpsMax;
+        unsigned int frameRows, frameColumns;
+        std::vector< float > scene;     // rendered frame without noise
+        std::vector< float > noise;
+
+        // streaming state, guarded by stateMutex
+        std::mutex stateMutex;
+        std::condition_variable stateCondition;
+        bool streaming, delivering, quit;
+        long long remaining;            // frames left, -1 streams until stop
+        bool countErrors;
+        std::chrono::steady_clock::time_point endTime;
+        bool timed;
+        unsigned long long dropCount;
+        std::thread streamThread;
+
+        // owned by the streaming thread
+        std::vector< float > frame;
+        unsigned long long frameId;
+        unsigned int noiseSeed;
+        std::chrono::steady_clock::time_point epoch;
+
+        void addEnum(const std::string& name, const char* const* choices, unsigned int count, unsigned int current);
+        void addNumber(const std::string& name, double min_value, double max_value, double step, double current);
+        Param& find(const char* name);
+        const Param& find(const char* name) const;
+        double number(const char* name) const;
+        const std::string& choice(const char* name) const;
+        static std::string format(const Param& param);
+
+        bool apply(Param& param, double value);
+        void stage(const char* name, const std::string* str_value, double num_value);
+        bool updateRanges();
+        void renderScene();
+        void notifyParam(const Param& param);
+        void notifyRange(const Param& param);
+        void notifyFps(double min_fps, double max_fps, double fps);
+
+        void streamLoop();
+        void deliverFrame();
+};
+
+#endif // SIMULATEDDEVICE_H_INCLUDED
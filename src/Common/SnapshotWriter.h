@@ -0,0 +1,39 @@
+#ifndef SNAPSHOTWRITER_H_INCLUDED
+#define SNAPSHOTWRITER_H_INCLUDED
+
+#include <NITSnapshot.h>
+#include <NITFrame.h>
+
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/** NITSnapshot that signals every frame it has written                                     **/
+/** The SDK snapshot only exposes its file counter, waitForCounter() blocks on that counter **/
+/** instead of polling it from the caller thread.                                           **/
+/** Frames only reach the SDK snapshot while armed: the SDK keeps the snap count of a      **/
+/** capture that timed out and would write the next frames of any stream, disarm() drops   **/
+/** that count.                                                                             **/
+class SnapshotWriter : public NITLibrary::NITToolBox::NITSnapshot
+{
+    public:
+        SnapshotWriter();
+        ~SnapshotWriter();
+
+        /** Write the next frame_count frames, the count of an earlier capture is dropped **/
+        void arm(unsigned int frame_count);
+        /** Write no more frames **/
+        void disarm();
+        /** Block until the file counter reached counter, false if deadline passed first **/
+        bool waitForCounter(unsigned int counter, const std::chrono::steady_clock::time_point& deadline);
+
+    private:
+        std::mutex snapMutex;
+        std::condition_variable frameCondition;
+        unsigned int remaining;         // frames still handed to the SDK snapshot
+
+        /** WE ARE NOT IN THE MAIN THREAD. **/
+        void onNewFrame(const NITLibrary::NITFrame& frame);
+};
+
+#endif // SNAPSHOTWRITER_H_INCLUDED
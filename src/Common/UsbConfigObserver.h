@@ -2,13 +2,23 @@
 #define USBCONFIGOBSERVER_H_INCLUDED
 
 #include <NITConfigObserver.h>
+#include <NITException.h>
+
+#include "ParamCache.h"
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
 
 /** This class permits to track the modifications of the device parameters                                      **/
 /** As soon as it is connected to the NITDevice, onParamRangeChanged is called for each parameter of the device **/
 class UsbConfigObserver : public NITLibrary::NITConfigObserver
 {
     public:
-        UsbConfigObserver() : displayNewFrame(false), frameCount(0)
+        UsbConfigObserver() : displayNewFrame(false), frameCount(0), receivedFrameCount(0), droppedFrameCount(0),
+                              statusCounts(STATUS_CODES + 1)
         {
         }
 
@@ -20,16 +30,68 @@ class UsbConfigObserver : public NITLibrary::NITConfigObserver
             displayNewFrame = b;
         }
 
+        /** Shadow copy of the device parameters, kept up to date by the callbacks below **/
+        ParamCache& params() { return paramCache; }
+
+        /** Number of frames received with status 0 since the observer was connected **/
+        unsigned long long receivedFrames()
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            return receivedFrameCount;
+        }
+
+        /** Number of frames the device reported with a non zero status (lost before the pipeline) **/
+        unsigned long long droppedFrames()
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            return droppedFrameCount;
+        }
+
+        /** Number of frames the device reported with this status since the observer was connected **/
+        /** Codes outside [0, STATUS_CODES) share one counter, any of them returns it                **/
+        unsigned long long statusCount(int status)
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            return statusCounts[statusSlot(status)];
+        }
+
+        static const int STATUS_CODES = 16;
+
+        /** Block the calling thread until receivedFrames() reaches count        **/
+        /** Return false if timeout_ms milliseconds elapsed before that          **/
+        bool waitForFrames(unsigned long long count, int timeout_ms)
+        {
+            std::unique_lock<std::mutex> lock(frameMutex);
+            return frameCondition.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                           [this, count] { return receivedFrameCount >= count; });
+        }
+
     private:
+        // the simulated device calls the callbacks below, as the SDK devices do
+        friend class SimulatedDevice;
 
         bool displayNewFrame;
         int frameCount;
 
+        std::mutex frameMutex;
+        std::condition_variable frameCondition;
+        unsigned long long receivedFrameCount;
+        unsigned long long droppedFrameCount;
+        std::vector< unsigned long long > statusCounts;     // one per code, the last one for the others
+
+        static size_t statusSlot(int status)
+        {
+            return status >= 0 && status < STATUS_CODES ? (size_t)status : (size_t)STATUS_CODES;
+        }
+
+        ParamCache paramCache;
+
         /** Called each time a parameter is changed by calling setParamValueOf **/
         /**    for the changed parameter and the dependent parameter if any.    **/
         /** We are in the thread who called setParamValueOf.                    **/
         void onParamChanged(const char *param_name, const char *str_value, float num_value)
         {
+            paramCache.update(param_name, str_value, num_value);
             std::cout << "- ConfigObserver: Parameter " << param_name << " changed to " << str_value << std::endl;
         }
 
@@ -38,6 +100,8 @@ class UsbConfigObserver : public NITLibrary::NITConfigObserver
         void onParamRangeChanged(const char *param_name, const char *str_values[], const float *num_values, unsigned int array_size,
                                                                                             const char *cur_str_val, float cur_num_val)
         {
+            paramCache.update(param_name, cur_str_val, cur_num_val);
+
             if( array_size == 0 )
                 std::cout << "- ConfigObserver: " << param_name << " new Range [empty] value set to " << cur_str_val << std::endl;
             else if( array_size == 1 )
@@ -80,6 +144,22 @@ class UsbConfigObserver : public NITLibrary::NITConfigObserver
         /** WE ARE NOT IN THE MAIN THREAD.                                  **/
         void onNewFrame(int status)
         {
+            if( status == 0 )
+            {
+                {
+                    std::lock_guard<std::mutex> lock(frameMutex);
+                    ++statusCounts[statusSlot(status)];
+                    ++receivedFrameCount;
+                }
+                frameCondition.notify_all();
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(frameMutex);
+                ++statusCounts[statusSlot(status)];
+                ++droppedFrameCount;
+            }
+
             //An output to cout is done only if displayNewFrame as been set to true by calling DisplayNewFrame(true)
             if( displayNewFrame )
                 std::cout << "- ConfigObserver: Frame " << ++frameCount << " " << status << std::endl;
@@ -95,7 +175,7 @@ class UsbConfigObserver : public NITLibrary::NITConfigObserver
 
         /** Called when an error occurs in an internal thread               **/
         /** WE ARE NOT IN THE MAIN THREAD.                                  **/
-        void onInternalError(const NITException &exc)
+        void onInternalError(const NITLibrary::NITException &exc)
         {
             std::cout << "- ConfigObserver: Internal Error " << exc.what() << std::endl;
         }
@@ -0,0 +1,44 @@
+#ifndef WORKERPOOL_H_INCLUDED
+#define WORKERPOOL_H_INCLUDED
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/** A fixed set of threads to split per-frame work into bands                          **/
+/** The threads are started once and sleep between jobs, so a job costs two wake-ups   **/
+/** instead of creating threads for every frame.                                         **/
+class WorkerPool
+{
+    public:
+        /** thread_count 0 uses one thread per hardware thread **/
+        explicit WorkerPool(unsigned int thread_count = 0);
+        ~WorkerPool();
+
+        /** Number of bands a job is split into (worker threads + the calling thread) **/
+        unsigned int size() const { return (unsigned int)workers.size() + 1; }
+
+        /** Split [0, count) into size() contiguous bands and call band(begin, end) for each of them **/
+        /** The calling thread runs the first band and returns when all bands are done              **/
+        /** Jobs are serialized, calling parallelFor from several threads is safe                 **/
+        void parallelFor(size_t count, const std::function<void(size_t, size_t)>& band);
+
+    private:
+        std::vector< std::thread > workers;
+
+        std::mutex jobMutex;            // one job at a time
+        std::mutex stateMutex;
+        std::condition_variable wakeUp, done;
+        const std::function<void(size_t, size_t)>* job;
+        size_t jobCount;
+        unsigned long long generation;
+        unsigned int running;
+        bool quit;
+
+        void run(unsigned int index);
+        void bandRange(unsigned int index, size_t& begin, size_t& end) const;
+};
+
+#endif // WORKERPOOL_H_INCLUDED
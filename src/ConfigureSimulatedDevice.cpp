@@ -0,0 +1,29 @@
+#include "CameraSelector.h"
+// listed with the camera sources, built only when CameraSelector.h selects the simulated camera
+#if CAMERA_MODEL == SIMULATED_DEVICE
+
+#include "ConfigureSimulatedDevice.h"
+
+void ConfigureDevice(CameraDevice* dev) {
+	using namespace std;
+
+	// same start configuration as the WiDySenS samples
+	cout << "Camera : " << dev->commercialName() << endl;
+	dev->setParamValueOf("First Column", 0u);
+	dev->setParamValueOf("NumberOfColumns", dev->sensorWidth());
+	dev->setParamValueOf("First Line", 0u);
+	dev->setParamValueOf("Number of Lines", dev->sensorHeight());
+	dev->setParamValueOf("Mode", "Global Shutter");
+	dev->setParamValueOf("Sensor Response", "Lin");
+	dev->setParamValueOf("IntegrationMode", "Itr");
+	dev->setParamValueOf("AnalogGain", "Low");
+	dev->setParamValueOf("Exposure Time", 5000.0);
+	dev->setParamValueOf("Trigger Mode", "Disabled");
+	dev->updateConfig();
+
+	// run at the highest frame rate the configuration allows
+	dev->setFps(dev->maxFps());
+	dev->updateConfig();
+}
+
+#endif // CAMERA_MODEL
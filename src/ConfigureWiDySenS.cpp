@@ -1,6 +1,10 @@
+#include "CameraSelector.h"
+// listed with the simulated sources, built only when CameraSelector.h selects a real camera
+#if CAMERA_MODEL != SIMULATED_DEVICE
+
 #include "ConfigureWiDySenS.h"
 
-void ConfigureDevice(NITLibrary::NITDevice* dev) {
+void ConfigureDevice(CameraDevice* dev) {
 	using namespace std;
 
 	/* Parameters can be set by the function setParamValueOf                   */
@@ -72,4 +76,6 @@ void ConfigureDevice(NITLibrary::NITDevice* dev) {
 
 	dev->setFps((min_fps + max_fps) / 2);
 	dev->updateConfig();                             //Data is sent to the device param 'true'
-}
\ No newline at end of file
+}
+
+#endif // CAMERA_MODEL
@@ -0,0 +1,68 @@
+#include "CameraSelector.h"
+// listed with the camera sources, built only when CameraSelector.h selects the simulated camera
+#if CAMERA_MODEL == SIMULATED_DEVICE
+
+#include "CreateSimulatedDevice.h"
+#include "ConfigureSimulatedDevice.h"
+#include "SimulatedDevice.h"
+
+#include <cstdio>
+#include <mutex>
+#include <set>
+
+namespace
+{
+    // serial numbers of the devices not released yet
+    std::mutex openMutex;
+    std::set< std::string > openSerials;
+
+    SimulatedDevice* openSimulatedDevice(const std::string& serial_number)
+    {
+        std::lock_guard<std::mutex> lock(openMutex);
+        if( !openSerials.insert(serial_number).second )
+        {
+            std::cout << "The simulated camera " << serial_number << " is already open" << std::endl;
+            return NULL;
+        }
+        return new SimulatedDevice(SIMULATED_SENSOR_WIDTH, SIMULATED_SENSOR_HEIGHT, SIMULATED_MAX_FPS, serial_number);
+    }
+}
+
+CameraDevice* CreateDevice()
+{
+    // there is no discovery, the simulated camera is always there
+    std::cout << "Using the simulated camera " << SIMULATED_SENSOR_WIDTH << "x" << SIMULATED_SENSOR_HEIGHT
+              << " up to " << SIMULATED_MAX_FPS << " fps" << std::endl;
+    return openSimulatedDevice("SIM0001");
+}
+
+CameraDevice* CreateDevice(const std::string& serial_number)
+{
+    std::cout << "Using the simulated camera " << serial_number << std::endl;
+    return openSimulatedDevice(serial_number);
+}
+
+void ReleaseDevice(CameraDevice* dev)
+{
+    if( dev == NULL )
+        return;
+    {
+        std::lock_guard<std::mutex> lock(openMutex);
+        openSerials.erase(dev->serialNumber());
+    }
+    delete dev;
+}
+
+std::vector< std::string > DiscoverSerialNumbers()
+{
+    std::vector< std::string > serial_numbers;
+    for( unsigned int i = 1; i <= SIMULATED_CAMERA_COUNT; ++i )
+    {
+        char serial_number[16];
+        snprintf(serial_number, sizeof(serial_number), "SIM%04u", i);
+        serial_numbers.push_back(serial_number);
+    }
+    return serial_numbers;
+}
+
+#endif // CAMERA_MODEL
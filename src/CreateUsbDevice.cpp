@@ -1,8 +1,19 @@
+#include "CameraSelector.h"
+// listed with the simulated sources, built only when CameraSelector.h selects a real camera
+#if CAMERA_MODEL != SIMULATED_DEVICE
+
 #include "CreateUsbDevice.h"
+#include "SdkDevice.h"
+
+#include <mutex>
 
-NITLibrary::NITDevice* CreateDevice()
+// NITCamArray opens its cameras from several threads, the NITManager singleton is not meant for that
+static std::mutex managerMutex;
+
+CameraDevice* CreateDevice()
 {
     using namespace NITLibrary;
+    std::lock_guard<std::mutex> lock(managerMutex);
     // NITManager is a class instantiated as a singleton which gather informations about the connected cameras.
     // This is called the discovery process.
     NITManager& nm = NITManager::getInstance();
@@ -25,5 +36,52 @@ NITLibrary::NITDevice* CreateDevice()
     //NITDevice* dev = nm.openDevice( index ); //Index is the position of the camera in the device list
     //NITDevice* dev = nm.openDeviceBySerialNumber( sn ) with sn the serial number of the device.
 
-    return dev;
-}
\ No newline at end of file
+    return dev != NULL ? new SdkDevice(dev) : NULL;
+}
+
+CameraDevice* CreateDevice(const std::string& serial_number)
+{
+    using namespace NITLibrary;
+    std::lock_guard<std::mutex> lock(managerMutex);
+    NITManager& nm = NITManager::getInstance();
+
+    if (nm.deviceCount() == 0)
+    {
+        std::cout << "No NIT camera was discovered" << std::endl;
+        return NULL;
+    }
+
+    // throws a NITException if no discovered camera has this serial number
+    NITDevice* dev = nm.openBySerialNumber(serial_number);
+    return dev != NULL ? new SdkDevice(dev) : NULL;
+}
+
+std::vector< std::string > DiscoverSerialNumbers()
+{
+    using namespace NITLibrary;
+    std::lock_guard<std::mutex> lock(managerMutex);
+    NITManager& nm = NITManager::getInstance();
+
+    std::vector< std::string > serial_numbers;
+    if (nm.deviceCount() == 0)
+        return serial_numbers;
+
+    std::vector< DeviceInfo* > infos = nm.getCurrentDeviceInfoList();
+    for (size_t i = 0; i < infos.size(); ++i)
+        serial_numbers.push_back(nm.serialNumber(infos[i]));
+    return serial_numbers;
+}
+
+void ReleaseDevice(CameraDevice* dev)
+{
+    using namespace NITLibrary;
+    std::lock_guard<std::mutex> lock(managerMutex);
+    if (dev != NULL)
+    {
+        // CreateDevice only hands out SdkDevices
+        NITManager::getInstance().releaseDevice(static_cast< SdkDevice* >(dev)->device());
+        delete dev;
+    }
+}
+
+#endif // CAMERA_MODEL
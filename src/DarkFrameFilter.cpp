@@ -0,0 +1,58 @@
+#include "DarkFrameFilter.h"
+#include "GainKernels.h"
+
+#include <cmath>
+
+DarkFrameFilter::DarkFrameFilter() : correctedCount(0), mismatchCount(0)
+{
+}
+
+DarkFrameFilter::~DarkFrameFilter()
+{
+}
+
+void DarkFrameFilter::setReference(unsigned int rows, unsigned int columns, const float* dark)
+{
+    std::shared_ptr<Reference> reference = std::make_shared<Reference>();
+    reference->rows = rows;
+    reference->columns = columns;
+    reference->pixels.resize((size_t)rows * columns);
+    for( size_t i = 0; i < reference->pixels.size(); ++i )
+        reference->pixels[i] = std::nearbyint(dark[i]);
+    std::atomic_store(&current, std::shared_ptr<const Reference>(reference));
+}
+
+void DarkFrameFilter::clearReference()
+{
+    std::atomic_store(&current, std::shared_ptr<const Reference>());
+}
+
+bool DarkFrameFilter::hasReference() const
+{
+    return std::atomic_load(&current) != NULL;
+}
+
+const float* DarkFrameFilter::reference(unsigned int& rows, unsigned int& columns) const
+{
+    // only called from the main thread, which is also the only one replacing the reference
+    std::shared_ptr<const Reference> reference = std::atomic_load(&current);
+    rows = reference ? reference->rows : 0;
+    columns = reference ? reference->columns : 0;
+    return reference ? reference->pixels.data() : NULL;
+}
+
+void DarkFrameFilter::onNewFrame(NITLibrary::NITFrame& frame)
+{
+    std::shared_ptr<const Reference> reference = std::atomic_load(&current);
+    if( !reference || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+        return;
+
+    if( frame.rows() != reference->rows || frame.columns() != reference->columns )
+    {
+        mismatchCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    subtractClamp(frame.data(), reference->pixels.data(), reference->pixels.size());
+    correctedCount.fetch_add(1, std::memory_order_relaxed);
+}
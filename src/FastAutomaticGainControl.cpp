@@ -0,0 +1,207 @@
+#include "FastAutomaticGainControl.h"
+#include "GainKernels.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    const size_t HISTOGRAM_BINS = 16384;        // 14-bit levels
+    const unsigned int SPARSE_STEP = 16;        // grid of the scene change test
+}
+
+FastAutomaticGainControl::FastAutomaticGainControl(unsigned int ignored_below, unsigned int ignored_above, unsigned int thread_count)
+    : pool(thread_count), histogram(HISTOGRAM_BINS), primed(false), minLevel(0.0f), maxLevel(0.0f),
+      referenceMean(0.0f), framesSinceHistogram(0), resetPending(false), limits(0), histogramCount(0), sceneChangeCount(0)
+{
+    settings.ignoredBelow = ignored_below;
+    settings.ignoredAbove = ignored_above;
+    settings.subsample = 1;
+    settings.smoothing = 1.0f;
+    settings.refreshInterval = 1;
+    settings.sceneChange = 0.25f;
+
+    bandHistograms.resize(pool.size(), std::vector< unsigned int >(HISTOGRAM_BINS));
+}
+
+FastAutomaticGainControl::~FastAutomaticGainControl()
+{
+}
+
+void FastAutomaticGainControl::setIgnoredPixels(unsigned int pixels_below, unsigned int pixels_above)
+{
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    settings.ignoredBelow = pixels_below;
+    settings.ignoredAbove = pixels_above;
+}
+
+void FastAutomaticGainControl::getIgnoredPixels(unsigned int& pixels_below, unsigned int& pixels_above) const
+{
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    pixels_below = settings.ignoredBelow;
+    pixels_above = settings.ignoredAbove;
+}
+
+void FastAutomaticGainControl::getMinMaxValue(unsigned short& min_value, unsigned short& max_value) const
+{
+    unsigned int l = limits.load(std::memory_order_relaxed);
+    min_value = (unsigned short)(l & 0xFFFF);
+    max_value = (unsigned short)(l >> 16);
+}
+
+void FastAutomaticGainControl::setSubsample(unsigned int step)
+{
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    settings.subsample = std::max(step, 1u);
+}
+
+void FastAutomaticGainControl::setRoi(const NITLibrary::NITToolBox::Roi& roi)
+{
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    settings.roi = roi;
+}
+
+void FastAutomaticGainControl::setTemporalFilter(float smoothing, unsigned int refresh_interval, float scene_change)
+{
+    {
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        settings.smoothing = std::min(std::max(smoothing, 0.001f), 1.0f);
+        settings.refreshInterval = std::max(refresh_interval, 1u);
+        settings.sceneChange = std::max(scene_change, 0.0f);
+    }
+    resetPending.store(true);
+}
+
+size_t FastAutomaticGainControl::buildHistogram(const float* pixels, unsigned int columns, unsigned int top, unsigned int bottom,
+                                                unsigned int left, unsigned int right, unsigned int step)
+{
+    size_t sampled_rows = (bottom - top + step - 1) / step;
+    size_t sampled_columns = (right - left + step - 1) / step;
+    size_t bands = bandHistograms.size();
+
+    // one job item per band so each band owns its histogram, no atomics on the bins
+    pool.parallelFor(bands, [&](size_t first_band, size_t last_band)
+    {
+        for( size_t b = first_band; b < last_band; ++b )
+        {
+            unsigned int* bins = bandHistograms[b].data();
+            std::fill(bins, bins + HISTOGRAM_BINS, 0u);
+            size_t row_begin = sampled_rows * b / bands;
+            size_t row_end = sampled_rows * (b + 1) / bands;
+            for( size_t r = row_begin; r < row_end; ++r )
+            {
+                const float* row = pixels + (size_t)(top + r * step) * columns + left;
+                accumulateHistogram14(row, sampled_columns, step, bins);
+            }
+        }
+    });
+
+    std::copy(bandHistograms[0].begin(), bandHistograms[0].end(), histogram.begin());
+    for( size_t b = 1; b < bands; ++b )
+    {
+        const unsigned int* bins = bandHistograms[b].data();
+        for( size_t i = 0; i < HISTOGRAM_BINS; ++i )
+            histogram[i] += bins[i];
+    }
+    return sampled_rows * sampled_columns;
+}
+
+void FastAutomaticGainControl::clipPoints(size_t below, size_t above, float& low, float& high) const
+{
+    size_t low_bin = 0, count = 0;
+    for( ; low_bin < HISTOGRAM_BINS - 1; ++low_bin )
+    {
+        count += histogram[low_bin];
+        if( count > below )
+            break;
+    }
+    size_t high_bin = HISTOGRAM_BINS - 1;
+    count = 0;
+    for( ; high_bin > 0; --high_bin )
+    {
+        count += histogram[high_bin];
+        if( count > above )
+            break;
+    }
+    if( high_bin <= low_bin )
+        high_bin = std::min(low_bin + 1, HISTOGRAM_BINS - 1);
+
+    low = (float)low_bin;
+    high = (float)high_bin;
+}
+
+float FastAutomaticGainControl::sparseMean(const float* pixels, unsigned int columns, unsigned int top, unsigned int bottom,
+                                           unsigned int left, unsigned int right)
+{
+    double sum = 0.0;
+    size_t count = 0;
+    for( unsigned int r = top; r < bottom; r += SPARSE_STEP )
+    {
+        const float* row = pixels + (size_t)r * columns;
+        for( unsigned int c = left; c < right; c += SPARSE_STEP )
+            sum += row[c];
+        count += (right - left + SPARSE_STEP - 1) / SPARSE_STEP;
+    }
+    return count ? (float)(sum / count) : 0.0f;
+}
+
+void FastAutomaticGainControl::onNewFrame(NITLibrary::NITFrame& frame)
+{
+    // like the SDK gain controls, color frames pass through untouched
+    if( frame.pixelType() != NITLibrary::NITFrame::FLOAT || frame.rows() == 0 || frame.columns() == 0 )
+        return;
+
+    Settings s;
+    {
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        s = settings;
+    }
+    if( resetPending.exchange(false) )
+        primed = false;
+
+    unsigned int rows = frame.rows(), columns = frame.columns();
+    unsigned int top = 0, bottom = rows, left = 0, right = columns;
+    if( !s.roi.empty() )
+    {
+        top = std::min<unsigned int>(s.roi.yTop, rows - 1);
+        bottom = std::max(std::min<unsigned int>(s.roi.yBottom, rows), top + 1);
+        left = std::min<unsigned int>(s.roi.xLeft, columns - 1);
+        right = std::max(std::min<unsigned int>(s.roi.xRight, columns), left + 1);
+    }
+    float* pixels = frame.data();
+
+    // a few thousand pixels, cheap next to a histogram
+    float mean = sparseMean(pixels, columns, top, bottom, left, right);
+    bool scene_change = primed && std::fabs(mean - referenceMean) > s.sceneChange * std::max(maxLevel - minLevel, 1.0f);
+    bool rebuild = !primed || scene_change || ++framesSinceHistogram >= s.refreshInterval;
+
+    if( rebuild )
+    {
+        size_t sampled = buildHistogram(pixels, columns, top, bottom, left, right, s.subsample);
+        double fraction = (double)sampled / ((double)rows * columns);
+        float low, high;
+        clipPoints((size_t)(s.ignoredBelow * fraction), (size_t)(s.ignoredAbove * fraction), low, high);
+
+        if( !primed || scene_change )
+        {
+            minLevel = low;
+            maxLevel = high;
+        }
+        else
+        {
+            minLevel += s.smoothing * (low - minLevel);
+            maxLevel += s.smoothing * (high - maxLevel);
+        }
+        referenceMean = mean;
+        framesSinceHistogram = 0;
+        primed = true;
+
+        histogramCount.fetch_add(1, std::memory_order_relaxed);
+        if( scene_change )
+            sceneChangeCount.fetch_add(1, std::memory_order_relaxed);
+        limits.store((unsigned int)std::lrint(minLevel) | ((unsigned int)std::lrint(maxLevel) << 16), std::memory_order_relaxed);
+    }
+
+    float scale = 255.0f / std::max(maxLevel - minLevel, 1.0f);
+    gainFloat(pixels, (size_t)rows * columns, scale, -minLevel * scale);
+}
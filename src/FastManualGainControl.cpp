@@ -0,0 +1,58 @@
+#include "FastManualGainControl.h"
+#include "GainKernels.h"
+
+FastManualGainControl::FastManualGainControl(unsigned short low_limit, unsigned short high_limit)
+{
+    setMinMaxValue(low_limit, high_limit);
+}
+
+FastManualGainControl::~FastManualGainControl()
+{
+}
+
+void FastManualGainControl::setMinMaxValue(unsigned short low_limit, unsigned short high_limit)
+{
+    limits.store((unsigned int)low_limit | ((unsigned int)high_limit << 16), std::memory_order_relaxed);
+}
+
+void FastManualGainControl::getMinMaxValue(unsigned short& min_value, unsigned short& max_value) const
+{
+    unsigned int l = limits.load(std::memory_order_relaxed);
+    min_value = (unsigned short)(l & 0xFFFF);
+    max_value = (unsigned short)(l >> 16);
+}
+
+void FastManualGainControl::scaleOffset(float& scale, float& offset) const
+{
+    unsigned short low, high;
+    getMinMaxValue(low, high);
+    // degenerate range: everything at or above low goes white
+    float range = high > low ? (float)(high - low) : 1.0f;
+    scale = 255.0f / range;
+    offset = -(float)low * scale;
+}
+
+void FastManualGainControl::convert(const unsigned short* src, unsigned char* dst, size_t count) const
+{
+    float scale, offset;
+    scaleOffset(scale, offset);
+    gainToUint8(src, dst, count, scale, offset);
+}
+
+void FastManualGainControl::convert(const float* src, unsigned char* dst, size_t count) const
+{
+    float scale, offset;
+    scaleOffset(scale, offset);
+    gainToUint8(src, dst, count, scale, offset);
+}
+
+void FastManualGainControl::onNewFrame(NITLibrary::NITFrame& frame)
+{
+    // like the SDK gain controls, color frames pass through untouched
+    if( frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+        return;
+
+    float scale, offset;
+    scaleOffset(scale, offset);
+    gainFloat(frame.data(), (size_t)frame.rows() * frame.columns(), scale, offset);
+}
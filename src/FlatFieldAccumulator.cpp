@@ -0,0 +1,129 @@
+#include "FlatFieldAccumulator.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    // samples a pixel needs before its deviation is trusted for the rejection
+    const unsigned int WARMUP_FRAMES = 8;
+}
+
+FlatFieldAccumulator::FlatFieldAccumulator() : armed(false), frameRows(0), frameColumns(0),
+                                               capacity(0), accumulated(0), dropped(0), rejected(0), rejectSigma(0.0f)
+{
+}
+
+FlatFieldAccumulator::~FlatFieldAccumulator()
+{
+}
+
+void FlatFieldAccumulator::arm(unsigned int frame_count, unsigned int rows, unsigned int columns, float reject_sigma)
+{
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+
+    size_t pixel_count = (size_t)rows * columns;
+    means.assign(pixel_count, 0.0);
+    squares.assign(pixel_count, 0.0);
+    counts.assign(pixel_count, 0);
+
+    frameRows = rows;
+    frameColumns = columns;
+    capacity = frame_count;
+    accumulated = 0;
+    dropped = 0;
+    rejected = 0;
+    rejectSigma = reject_sigma;
+    armed = true;
+}
+
+void FlatFieldAccumulator::disarm()
+{
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    armed = false;
+}
+
+unsigned int FlatFieldAccumulator::frames()
+{
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    return accumulated;
+}
+
+unsigned int FlatFieldAccumulator::droppedFrames()
+{
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    return dropped;
+}
+
+unsigned long long FlatFieldAccumulator::rejectedSamples()
+{
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    return rejected;
+}
+
+void FlatFieldAccumulator::result(std::vector< float >& mean, std::vector< float >& stddev)
+{
+    std::lock_guard<std::mutex> lock(accumulatorMutex);
+    mean.resize(means.size());
+    stddev.resize(means.size());
+    for( size_t i = 0; i < means.size(); ++i )
+    {
+        mean[i] = (float)means[i];
+        stddev[i] = counts[i] > 1 ? (float)std::sqrt(squares[i] / (counts[i] - 1)) : 0.0f;
+    }
+}
+
+bool FlatFieldAccumulator::waitForFrames(unsigned int count, const std::chrono::steady_clock::time_point& deadline)
+{
+    std::unique_lock<std::mutex> lock(accumulatorMutex);
+    frameCondition.wait_until(lock, deadline, [this, count] { return accumulated >= count || dropped > 0; });
+    return accumulated >= count;
+}
+
+void FlatFieldAccumulator::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(accumulatorMutex);
+        accumulate(frame);
+    }
+    frameCondition.notify_all();
+}
+
+void FlatFieldAccumulator::accumulate(const NITLibrary::NITFrame& frame)
+{
+    if( !armed || accumulated >= capacity )
+        return;
+
+    if( frame.rows() != frameRows || frame.columns() != frameColumns || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+    {
+        ++dropped;
+        return;
+    }
+
+    const float* pixels = frame.data();
+    double sigma2 = (double)rejectSigma * rejectSigma;
+    unsigned long long frame_rejected = 0;
+    for( size_t i = 0; i < means.size(); ++i )
+    {
+        double x = pixels[i];
+        double delta = x - means[i];
+        unsigned int n = counts[i];
+        if( rejectSigma > 0.0f && n >= WARMUP_FRAMES )
+        {
+            // squared comparison, no sqrt per pixel; a quantized, noiseless pixel still gets one level
+            double variance = std::max(squares[i] / (n - 1), 1.0);
+            if( delta * delta > sigma2 * variance )
+            {
+                ++frame_rejected;
+                continue;
+            }
+        }
+        ++n;
+        double mean = means[i] + delta / n;
+        squares[i] += delta * (x - mean);
+        means[i] = mean;
+        counts[i] = n;
+    }
+    rejected += frame_rejected;
+    ++accumulated;
+}
@@ -0,0 +1,190 @@
+#include "FrameAverager.h"
+#include "SimdSupport.h"
+
+#include <algorithm>
+
+namespace
+{
+    void addScalar(float* sum, const float* src, size_t count)
+    {
+        for( size_t i = 0; i < count; ++i )
+            sum[i] += src[i];
+    }
+
+    void blendScalar(float* mean, const float* src, size_t count, float alpha)
+    {
+        for( size_t i = 0; i < count; ++i )
+            mean[i] += alpha * (src[i] - mean[i]);
+    }
+
+    void scaleScalar(float* dst, const float* src, size_t count, float scale)
+    {
+        for( size_t i = 0; i < count; ++i )
+            dst[i] = src[i] * scale;
+    }
+
+    SIMD_TARGET_SSE41 void addSse41(float* sum, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+            _mm_storeu_ps(sum + i, _mm_add_ps(_mm_loadu_ps(sum + i), _mm_loadu_ps(src + i)));
+        addScalar(sum + i, src + i, count - i);
+    }
+
+    SIMD_TARGET_SSE41 void blendSse41(float* mean, const float* src, size_t count, float alpha)
+    {
+        const __m128 a = _mm_set1_ps(alpha);
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+        {
+            __m128 m = _mm_loadu_ps(mean + i);
+            _mm_storeu_ps(mean + i, _mm_add_ps(m, _mm_mul_ps(a, _mm_sub_ps(_mm_loadu_ps(src + i), m))));
+        }
+        blendScalar(mean + i, src + i, count - i, alpha);
+    }
+
+    SIMD_TARGET_SSE41 void scaleSse41(float* dst, const float* src, size_t count, float scale)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), s));
+        scaleScalar(dst + i, src + i, count - i, scale);
+    }
+
+    SIMD_TARGET_AVX2 void addAvx2(float* sum, const float* src, size_t count)
+    {
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            _mm256_storeu_ps(sum + i, _mm256_add_ps(_mm256_loadu_ps(sum + i), _mm256_loadu_ps(src + i)));
+            _mm256_storeu_ps(sum + i + 8, _mm256_add_ps(_mm256_loadu_ps(sum + i + 8), _mm256_loadu_ps(src + i + 8)));
+        }
+        addScalar(sum + i, src + i, count - i);
+    }
+
+    SIMD_TARGET_AVX2 void blendAvx2(float* mean, const float* src, size_t count, float alpha)
+    {
+        const __m256 a = _mm256_set1_ps(alpha);
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8 )
+        {
+            __m256 m = _mm256_loadu_ps(mean + i);
+            _mm256_storeu_ps(mean + i, _mm256_add_ps(m, _mm256_mul_ps(a, _mm256_sub_ps(_mm256_loadu_ps(src + i), m))));
+        }
+        blendScalar(mean + i, src + i, count - i, alpha);
+    }
+
+    SIMD_TARGET_AVX2 void scaleAvx2(float* dst, const float* src, size_t count, float scale)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8 )
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), s));
+        scaleScalar(dst + i, src + i, count - i, scale);
+    }
+
+    typedef void (*AddFunc)(float*, const float*, size_t);
+    typedef void (*BlendFunc)(float*, const float*, size_t, float);
+
+    const bool hasAvx2 = simdHasAvx2();
+    const bool hasSse41 = simdHasSse41();
+
+    const AddFunc addFrame = hasAvx2 ? addAvx2 : hasSse41 ? addSse41 : addScalar;
+    const BlendFunc blendFrame = hasAvx2 ? blendAvx2 : hasSse41 ? blendSse41 : blendScalar;
+    const BlendFunc scaleFrame = hasAvx2 ? scaleAvx2 : hasSse41 ? scaleSse41 : scaleScalar;
+}
+
+FrameAverager::FrameAverager() : averageMode(OFF), alpha(1.0f), blockSize(1), accumulated(0), frameRows(0), frameColumns(0)
+{
+}
+
+FrameAverager::~FrameAverager()
+{
+}
+
+void FrameAverager::setMode(eMode mode, double parameter)
+{
+    std::lock_guard<std::mutex> lock(averagerMutex);
+    averageMode = mode;
+    if( mode == EMA )
+        alpha = (float)std::min(std::max(parameter, 1e-6), 1.0);
+    if( mode == BLOCK )
+        blockSize = parameter >= 1.0 ? (unsigned int)parameter : 1;
+    accumulated = 0;
+}
+
+FrameAverager::eMode FrameAverager::mode() const
+{
+    std::lock_guard<std::mutex> lock(averagerMutex);
+    return averageMode;
+}
+
+double FrameAverager::parameter() const
+{
+    std::lock_guard<std::mutex> lock(averagerMutex);
+    return averageMode == EMA ? (double)alpha : averageMode == BLOCK ? (double)blockSize : 0.0;
+}
+
+void FrameAverager::reset()
+{
+    std::lock_guard<std::mutex> lock(averagerMutex);
+    accumulated = 0;
+}
+
+unsigned int FrameAverager::inputFrames(unsigned int frame_count) const
+{
+    std::lock_guard<std::mutex> lock(averagerMutex);
+    return averageMode == BLOCK ? frame_count * blockSize : frame_count;
+}
+
+void FrameAverager::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    std::unique_lock<std::mutex> lock(averagerMutex);
+    if( averageMode == OFF || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+    {
+        lock.unlock();
+        forward(frame);
+        return;
+    }
+
+    size_t count = (size_t)frame.rows() * frame.columns();
+    if( frame.rows() != frameRows || frame.columns() != frameColumns )
+    {
+        // a new size restarts the average
+        frameRows = frame.rows();
+        frameColumns = frame.columns();
+        accumulator.resize(count);
+        accumulated = 0;
+    }
+
+    ++accumulated;
+    if( accumulated == 1 )
+        std::copy(frame.data(), frame.data() + count, accumulator.begin());
+    else if( averageMode == EMA )
+        blendFrame(accumulator.data(), frame.data(), count, alpha);
+    else if( averageMode == RUNNING_MEAN )
+        blendFrame(accumulator.data(), frame.data(), count, 1.0f / accumulated);
+    else
+        addFrame(accumulator.data(), frame.data(), count);
+
+    if( averageMode == BLOCK && accumulated < blockSize )
+        return;
+
+    float* output = outputBuffer(count);
+    if( averageMode == BLOCK )
+    {
+        scaleFrame(output, accumulator.data(), count, 1.0f / accumulated);
+        accumulated = 0;
+    }
+    else
+    {
+        std::copy(accumulator.begin(), accumulator.end(), output);
+    }
+
+    // the downstream filters may take a while, the averager state is only touched under the lock
+    NITLibrary::NITFrame averaged(frame.bitsPerPixel(), output, frameColumns, frameRows,
+                                  frame.Id(), frame.temperature(), frame.gigeTimestamp());
+    lock.unlock();
+    forward(averaged);
+}
@@ -0,0 +1,163 @@
+#include "FrameBuffer.h"
+#include "PixelConvert.h"
+
+#include <utility>
+
+FrameBuffer::FrameBuffer() : armed(false), pixelFormat(UINT16), useColumnMajor(false), frameRows(0), frameColumns(0),
+                             capacity(0), collected(0), dropped(0), framesPerSlot(1), accumulated(0)
+{
+}
+
+FrameBuffer::~FrameBuffer()
+{
+}
+
+void FrameBuffer::arm(unsigned int frame_count, unsigned int rows, unsigned int columns, ePixelFormat format, bool column_major)
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+
+    size_t pixel_count = (size_t)frame_count * rows * columns;
+    // resize doesn't reallocate if the capture has the same size as the last one
+    if( format == UINT8 )
+        pixels8.resize(pixel_count);
+    else if( format == SINGLE )
+        pixelsSingle.resize(pixel_count);
+    else
+        pixels16.resize(pixel_count);
+
+    pixelFormat = format;
+    useColumnMajor = column_major;
+    frameRows = rows;
+    frameColumns = columns;
+    capacity = frame_count;
+    collected = 0;
+    dropped = 0;
+    framesPerSlot = 1;
+    accumulated = 0;
+    armed = true;
+}
+
+void FrameBuffer::setAveraging(unsigned int frames_per_slot)
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    framesPerSlot = frames_per_slot > 0 ? frames_per_slot : 1;
+    accumulated = 0;
+    if( framesPerSlot > 1 )
+        accumulator.assign((size_t)frameRows * frameColumns, 0.0f);
+}
+
+void FrameBuffer::disarm()
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    armed = false;
+}
+
+unsigned int FrameBuffer::frames()
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    return collected;
+}
+
+unsigned int FrameBuffer::droppedFrames()
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    return dropped;
+}
+
+size_t FrameBuffer::size()
+{
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    return (size_t)collected * frameRows * frameColumns;
+}
+
+void FrameBuffer::swap(FrameBuffer& other)
+{
+    if( &other == this )
+        return;
+    std::lock(bufferMutex, other.bufferMutex);
+    std::lock_guard<std::mutex> lock(bufferMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> other_lock(other.bufferMutex, std::adopt_lock);
+
+    pixels16.swap(other.pixels16);
+    pixels8.swap(other.pixels8);
+    pixelsSingle.swap(other.pixelsSingle);
+    std::swap(pixelFormat, other.pixelFormat);
+    std::swap(useColumnMajor, other.useColumnMajor);
+    std::swap(frameRows, other.frameRows);
+    std::swap(frameColumns, other.frameColumns);
+    std::swap(capacity, other.capacity);
+    std::swap(collected, other.collected);
+    std::swap(dropped, other.dropped);
+}
+
+bool FrameBuffer::waitForFrames(unsigned int count, const std::chrono::steady_clock::time_point& deadline)
+{
+    std::unique_lock<std::mutex> lock(bufferMutex);
+    frameCondition.wait_until(lock, deadline, [this, count] { return collected >= count || dropped > 0; });
+    return collected >= count;
+}
+
+void FrameBuffer::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        collect(frame);
+    }
+    frameCondition.notify_all();
+}
+
+void FrameBuffer::collect(const NITLibrary::NITFrame& frame)
+{
+    if( !armed || collected >= capacity )
+        return;
+
+    if( frame.rows() != frameRows || frame.columns() != frameColumns || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+    {
+        ++dropped;
+        return;
+    }
+
+    if( framesPerSlot == 1 )
+    {
+        store(frame.data(), 1.0f);
+        return;
+    }
+
+    const float* src = frame.data();
+    float* acc = accumulator.data();
+    size_t frame_size = accumulator.size();
+    for( size_t i = 0; i < frame_size; ++i )
+        acc[i] += src[i];
+
+    if( ++accumulated == framesPerSlot )
+    {
+        store(acc, 1.0f / framesPerSlot);
+        accumulator.assign(frame_size, 0.0f);
+        accumulated = 0;
+    }
+}
+
+void FrameBuffer::store(const float* src, float scale)
+{
+    size_t frame_size = (size_t)frameRows * frameColumns;
+    size_t offset = collected * frame_size;
+    if( useColumnMajor )
+    {
+        if( pixelFormat == UINT8 )
+            packUint8ColumnMajor(src, pixels8.data() + offset, frameRows, frameColumns, scale);
+        else if( pixelFormat == SINGLE )
+            packFloatColumnMajor(src, pixelsSingle.data() + offset, frameRows, frameColumns, scale);
+        else
+            packUint16ColumnMajor(src, pixels16.data() + offset, frameRows, frameColumns, scale);
+    }
+    else
+    {
+        if( pixelFormat == UINT8 )
+            packUint8(src, pixels8.data() + offset, frame_size, scale);
+        else if( pixelFormat == SINGLE )
+            packFloat(src, pixelsSingle.data() + offset, frame_size, scale);
+        else
+            packUint16(src, pixels16.data() + offset, frame_size, scale);
+    }
+    ++collected;
+}
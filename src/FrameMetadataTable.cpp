@@ -0,0 +1,161 @@
+#include "FrameMetadataTable.h"
+#include "MetadataFormat.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+    template< typename T >
+    void writeColumn(std::ofstream& out, const std::vector< T >& column, unsigned int count)
+    {
+        out.write(reinterpret_cast< const char* >(column.data()), (std::streamsize)(count * sizeof(T)));
+    }
+}
+
+FrameMetadataTable::FrameMetadataTable() : arrivalSource(NULL), armed(false), recorded(0), dropped(0), gatedMode(false), triggerDelay(0.0), exposureTime(0.0)
+{
+}
+
+FrameMetadataTable::~FrameMetadataTable()
+{
+}
+
+void FrameMetadataTable::arm(unsigned int frame_count)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+
+    // resize doesn't reallocate if the capture has the same size as the last one
+    idColumn.resize(frame_count);
+    hostTimeColumn.resize(frame_count);
+    temperatureColumn.resize(frame_count);
+    timestampColumn.resize(frame_count);
+    exposureColumn.resize(frame_count);
+    delayColumn.resize(frame_count);
+    gatedColumn.resize(frame_count);
+
+    recorded = 0;
+    dropped = 0;
+    armed = true;
+}
+
+void FrameMetadataTable::disarm()
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    armed = false;
+}
+
+void FrameMetadataTable::setSettings(bool gated_mode, double trigger_delay, double exposure_time)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    gatedMode = gated_mode;
+    triggerDelay = trigger_delay;
+    exposureTime = exposure_time;
+}
+
+void FrameMetadataTable::attachArrivals(const FrameStatistics* statistics)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    arrivalSource = statistics;
+}
+
+unsigned int FrameMetadataTable::frames()
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    return recorded;
+}
+
+unsigned int FrameMetadataTable::overflows()
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    return dropped;
+}
+
+bool FrameMetadataTable::write(const std::string& file_name)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+
+    std::ofstream out(file_name.c_str(), std::ios::binary);
+    if( !out )
+    {
+        std::cout << "Cannot create " << file_name << std::endl;
+        return false;
+    }
+
+    char header_block[METADATA_HEADER_SIZE] = {};
+    MetadataHeader header;
+    std::memcpy(header.magic, METADATA_MAGIC, sizeof(header.magic));
+    header.version = METADATA_VERSION;
+    header.headerSize = METADATA_HEADER_SIZE;
+    header.columnCount = METADATA_COLUMN_COUNT;
+    header.reserved = 0;
+    header.frameCount = recorded;
+    header.overflows = dropped;
+    std::memcpy(header_block, &header, sizeof(header));
+    out.write(header_block, sizeof(header_block));
+
+    // same order as MetadataFormat.h
+    writeColumn(out, idColumn, recorded);
+    writeColumn(out, hostTimeColumn, recorded);
+    writeColumn(out, temperatureColumn, recorded);
+    writeColumn(out, timestampColumn, recorded);
+    writeColumn(out, exposureColumn, recorded);
+    writeColumn(out, delayColumn, recorded);
+    writeColumn(out, gatedColumn, recorded);
+
+    out.close();
+    if( !out )
+    {
+        std::cout << "Cannot write " << file_name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void FrameMetadataTable::swap(FrameMetadataTable& other)
+{
+    if( &other == this )
+        return;
+    std::lock(tableMutex, other.tableMutex);
+    std::lock_guard<std::mutex> lock(tableMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> other_lock(other.tableMutex, std::adopt_lock);
+
+    idColumn.swap(other.idColumn);
+    hostTimeColumn.swap(other.hostTimeColumn);
+    temperatureColumn.swap(other.temperatureColumn);
+    timestampColumn.swap(other.timestampColumn);
+    exposureColumn.swap(other.exposureColumn);
+    delayColumn.swap(other.delayColumn);
+    gatedColumn.swap(other.gatedColumn);
+    std::swap(recorded, other.recorded);
+    std::swap(dropped, other.dropped);
+}
+
+void FrameMetadataTable::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    if( !armed )
+        return;
+    // the head of the pipeline stamped the frame, waiting for the lock doesn't count
+    std::chrono::steady_clock::time_point arrival;
+    if( arrivalSource == NULL || !arrivalSource->arrivalTime(frame.Id(), arrival) )
+        arrival = std::chrono::steady_clock::now();
+    double host_time = std::chrono::duration< double >(arrival.time_since_epoch()).count();
+    if( recorded >= idColumn.size() )
+    {
+        ++dropped;
+        return;
+    }
+
+    idColumn[recorded] = frame.Id();
+    hostTimeColumn[recorded] = host_time;
+    temperatureColumn[recorded] = frame.temperature();
+    timestampColumn[recorded] = frame.gigeTimestamp();
+    exposureColumn[recorded] = exposureTime;
+    delayColumn[recorded] = triggerDelay;
+    gatedColumn[recorded] = gatedMode ? 1 : 0;
+    ++recorded;
+}
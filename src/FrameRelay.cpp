@@ -0,0 +1,44 @@
+#include "FrameRelay.h"
+
+#include <cstddef>
+
+FrameRelay::FrameRelay()
+: nextBuffer(0)
+{
+}
+
+FrameRelay::~FrameRelay()
+{
+}
+
+FrameRelay& FrameRelay::operator<<(Connectable& next)
+{
+    downstream.push_back(&next);
+    return *this;
+}
+
+void FrameRelay::disconnectDownstream()
+{
+    downstream.clear();
+}
+
+void FrameRelay::forward(NITLibrary::NITFrame& frame)
+{
+    for( size_t i = 0; i < downstream.size(); ++i )
+        downstream[i]->onNewImage(frame);
+}
+
+void FrameRelay::forward(const NITLibrary::NITFrame& frame)
+{
+    // downstream filters work in place on the frame of the upstream filter, like they would
+    // directly behind it: connect the relay last if the upstream filter has other observers
+    forward(const_cast< NITLibrary::NITFrame& >(frame));
+}
+
+float* FrameRelay::outputBuffer(size_t count)
+{
+    std::vector< float >& buffer = buffers[nextBuffer];
+    nextBuffer = (nextBuffer + 1) % FORWARD_BUFFERS;
+    buffer.resize(count);
+    return buffer.data();
+}
@@ -0,0 +1,106 @@
+#include "FrameRing.h"
+#include "PixelConvert.h"
+
+#include <thread>
+
+FrameRing::FrameRing() : slotRows(0), slotColumns(0), useEightBit(false), enabled(false), inFlight(0),
+                         pushCount(0), overflowCount(0), mismatchCount(0), arrivalSource(NULL), head(0), tail(0)
+{
+}
+
+FrameRing::~FrameRing()
+{
+}
+
+void FrameRing::allocate(unsigned int slot_count, unsigned int rows, unsigned int columns, bool eight_bit)
+{
+    // a frame that saw the ring enabled still writes into its slot, let it finish
+    enabled.store(false);
+    while( inFlight.load() != 0 )
+        std::this_thread::yield();
+
+    size_t frame_size = (size_t)rows * columns;
+    slots.resize(slot_count);
+    for( size_t i = 0; i < slots.size(); ++i )
+    {
+        // only the pixel type in use keeps its memory
+        std::vector< unsigned short >(eight_bit ? 0 : frame_size).swap(slots[i].pixels16);
+        std::vector< unsigned char >(eight_bit ? frame_size : 0).swap(slots[i].pixels8);
+        slots[i].rows = rows;
+        slots[i].columns = columns;
+    }
+    slotRows = rows;
+    slotColumns = columns;
+    useEightBit = eight_bit;
+
+    head.store(0);
+    tail.store(0);
+    pushCount.store(0);
+    overflowCount.store(0);
+    mismatchCount.store(0);
+}
+
+const FrameRing::Slot* FrameRing::front() const
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    if( t == head.load(std::memory_order_acquire) )
+        return NULL;
+    return &slots[t % slots.size()];
+}
+
+void FrameRing::pop()
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    if( t != head.load(std::memory_order_acquire) )
+        tail.store(t + 1, std::memory_order_release);
+}
+
+unsigned int FrameRing::available() const
+{
+    return (unsigned int)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+}
+
+void FrameRing::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    // sequentially consistent with the store in allocate: either allocate sees the frame
+    // in flight or the frame sees the ring disabled
+    inFlight.fetch_add(1);
+    if( enabled.load() )
+        push(frame);
+    inFlight.fetch_sub(1);
+}
+
+void FrameRing::push(const NITLibrary::NITFrame& frame)
+{
+    if( slots.empty() )
+        return;
+
+    if( frame.rows() != slotRows || frame.columns() != slotColumns || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+    {
+        mismatchCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t h = head.load(std::memory_order_relaxed);
+    if( h - tail.load(std::memory_order_acquire) >= slots.size() )
+    {
+        // never block the streaming thread, the consumer sees the gap in the frame ids
+        overflowCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Slot& slot = slots[h % slots.size()];
+    size_t frame_size = (size_t)slotRows * slotColumns;
+    if( useEightBit )
+        packUint8(frame.data(), slot.pixels8.data(), frame_size);
+    else
+        packUint16(frame.data(), slot.pixels16.data(), frame_size);
+    slot.id = frame.Id();
+    slot.temperature = frame.temperature();
+    slot.timestamp = frame.gigeTimestamp();
+    if( arrivalSource == NULL || !arrivalSource->arrivalTime(slot.id, slot.received) )
+        slot.received = std::chrono::steady_clock::now();
+
+    head.store(h + 1, std::memory_order_release);
+    pushCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,150 @@
+#include "FrameStatistics.h"
+
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    const std::memory_order relaxed = std::memory_order_relaxed;
+}
+
+FrameStatistics::FrameStatistics() : sequence(0), resetPending(false), restartPending(false), streaming(false),
+                                     arrivals(ARRIVAL_HISTORY)
+{
+    clear();
+}
+
+FrameStatistics::~FrameStatistics()
+{
+}
+
+void FrameStatistics::clear()
+{
+    frameCount.store(0, relaxed);
+    gapCount.store(0, relaxed);
+    missingCount.store(0, relaxed);
+    largestGapSize.store(0, relaxed);
+    resetCount.store(0, relaxed);
+    lastFrameId.store(0, relaxed);
+    intervalCount.store(0, relaxed);
+    intervalMean.store(0.0, relaxed);
+    intervalM2.store(0.0, relaxed);
+    intervalMin.store(0.0, relaxed);
+    intervalMax.store(0.0, relaxed);
+    streaming = false;
+}
+
+FrameStatistics::Snapshot FrameStatistics::snapshot() const
+{
+    Snapshot s;
+    unsigned long long intervals;
+    double m2;
+    for(;;)
+    {
+        unsigned int before = sequence.load(std::memory_order_acquire);
+        if( before & 1 )
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        s.frames = frameCount.load(relaxed);
+        s.gaps = gapCount.load(relaxed);
+        s.missingFrames = missingCount.load(relaxed);
+        s.largestGap = largestGapSize.load(relaxed);
+        s.idResets = resetCount.load(relaxed);
+        s.lastId = lastFrameId.load(relaxed);
+        intervals = intervalCount.load(relaxed);
+        s.meanInterval = intervalMean.load(relaxed);
+        m2 = intervalM2.load(relaxed);
+        s.minInterval = intervalMin.load(relaxed);
+        s.maxInterval = intervalMax.load(relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if( sequence.load(relaxed) == before )
+            break;
+    }
+    // the counters are cleared by the next frame
+    if( resetPending.load() )
+        return Snapshot();
+
+    s.jitter = intervals > 1 ? std::sqrt(m2 / (double)(intervals - 1)) : 0.0;
+    return s;
+}
+
+void FrameStatistics::reset()
+{
+    resetPending.store(true);
+}
+
+void FrameStatistics::restartStream()
+{
+    restartPending.store(true);
+}
+
+bool FrameStatistics::arrivalTime(unsigned long long id, std::chrono::steady_clock::time_point& time) const
+{
+    std::lock_guard<std::mutex> lock(arrivalMutex);
+    const Arrival& arrival = arrivals[id % ARRIVAL_HISTORY];
+    if( !arrival.valid || arrival.id != id )
+        return false;
+    time = arrival.time;
+    return true;
+}
+
+void FrameStatistics::onNewFrame(NITLibrary::NITFrame& frame)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    unsigned long long id = frame.Id();
+    {
+        std::lock_guard<std::mutex> lock(arrivalMutex);
+        Arrival& arrival = arrivals[id % ARRIVAL_HISTORY];
+        arrival.id = id;
+        arrival.time = now;
+        arrival.valid = true;
+    }
+
+    unsigned int current = sequence.load(relaxed);
+    sequence.store(current + 1, relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if( resetPending.exchange(false) )
+        clear();
+    if( restartPending.exchange(false) )
+        streaming = false;
+
+    if( streaming )
+    {
+        unsigned long long last = lastFrameId.load(relaxed);
+        if( id > last + 1 )
+        {
+            unsigned long long missing = id - last - 1;
+            gapCount.store(gapCount.load(relaxed) + 1, relaxed);
+            missingCount.store(missingCount.load(relaxed) + missing, relaxed);
+            if( missing > largestGapSize.load(relaxed) )
+                largestGapSize.store(missing, relaxed);
+        }
+        else if( id <= last )
+        {
+            resetCount.store(resetCount.load(relaxed) + 1, relaxed);
+        }
+
+        // Welford: running mean and sum of squared deviations without keeping the intervals
+        double interval = std::chrono::duration< double, std::milli >(now - lastArrival).count();
+        unsigned long long n = intervalCount.load(relaxed) + 1;
+        double mean = intervalMean.load(relaxed);
+        double delta = interval - mean;
+        mean += delta / (double)n;
+        intervalMean.store(mean, relaxed);
+        intervalM2.store(intervalM2.load(relaxed) + delta * (interval - mean), relaxed);
+        intervalCount.store(n, relaxed);
+        if( n == 1 || interval < intervalMin.load(relaxed) )
+            intervalMin.store(interval, relaxed);
+        if( interval > intervalMax.load(relaxed) )
+            intervalMax.store(interval, relaxed);
+    }
+    streaming = true;
+    lastArrival = now;
+    lastFrameId.store(id, relaxed);
+    frameCount.store(frameCount.load(relaxed) + 1, relaxed);
+
+    sequence.store(current + 2, std::memory_order_release);
+}
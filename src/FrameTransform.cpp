@@ -0,0 +1,208 @@
+#include "FrameTransform.h"
+#include "SimdTranspose.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+    const unsigned int TILE = 32;
+
+    /** Source pixel (r, c) goes to dst[base + r * rowStep + c * colStep] **/
+    struct Mapping
+    {
+        ptrdiff_t base, rowStep, colStep;
+    };
+
+    Mapping mappingOf(FrameTransform::eTransform transform, unsigned int rows, unsigned int columns)
+    {
+        ptrdiff_t h = rows, w = columns;
+        switch( transform )
+        {
+            case FrameTransform::FLIP_HORIZONTAL:   return { w - 1, w, -1 };
+            case FrameTransform::FLIP_VERTICAL:     return { (h - 1) * w, -w, 1 };
+            case FrameTransform::ROTATE_180:        return { h * w - 1, -w, -1 };
+            case FrameTransform::TRANSPOSE:         return { 0, 1, h };
+            case FrameTransform::ROTATE_90:         return { h - 1, -1, h };
+            case FrameTransform::ROTATE_270:        return { (w - 1) * h, 1, -h };
+            default:                                return { 0, w, 1 };
+        }
+    }
+
+    bool swapsAxes(FrameTransform::eTransform transform)
+    {
+        return transform == FrameTransform::TRANSPOSE || transform == FrameTransform::ROTATE_90 || transform == FrameTransform::ROTATE_270;
+    }
+
+    void mapBlockScalar(const float* src, size_t columns, float* dst, const Mapping& m,
+                        unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1)
+    {
+        for( unsigned int r = r0; r < r1; ++r )
+        {
+            const float* s = src + r * columns;
+            float* d = dst + m.base + (ptrdiff_t)r * m.rowStep;
+            for( unsigned int c = c0; c < c1; ++c )
+                d[(ptrdiff_t)c * m.colStep] = s[c];
+        }
+    }
+
+    void reverseRowScalar(const float* src, float* dst, size_t count)
+    {
+        for( size_t i = 0; i < count; ++i )
+            dst[count - 1 - i] = src[i];
+    }
+
+    /** Transposing mappings (rowStep = +-1): a source column is a destination row **/
+    void transposeTileScalar(const float* src, size_t columns, float* dst, const Mapping& m,
+                             unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1)
+    {
+        // column by column, so the destination is written row by row
+        for( unsigned int c = c0; c < c1; ++c )
+        {
+            float* d = dst + m.base + (ptrdiff_t)c * m.colStep;
+            for( unsigned int r = r0; r < r1; ++r )
+                d[(ptrdiff_t)r * m.rowStep] = src[r * columns + c];
+        }
+    }
+
+    SIMD_TARGET_SSE41 void reverseRowSse41(const float* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+        {
+            __m128 v = _mm_loadu_ps(src + i);
+            _mm_storeu_ps(dst + count - 4 - i, _mm_shuffle_ps(v, v, 0x1B));
+        }
+        reverseRowScalar(src + i, dst, count - i);
+    }
+
+    SIMD_TARGET_SSE41 void transposeTileSse41(const float* src, size_t columns, float* dst, const Mapping& m,
+                                              unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1)
+    {
+        unsigned int r = r0;
+        for( ; r + 4 <= r1; r += 4 )
+        {
+            unsigned int c = c0;
+            for( ; c + 4 <= c1; c += 4 )
+            {
+                __m128 v[4];
+                simdTranspose4x4(src + r * columns + c, columns, v);
+                for( int k = 0; k < 4; ++k )
+                {
+                    float* d = dst + m.base + (ptrdiff_t)(c + k) * m.colStep + (ptrdiff_t)r * m.rowStep;
+                    if( m.rowStep > 0 )
+                        _mm_storeu_ps(d, v[k]);
+                    else
+                        _mm_storeu_ps(d - 3, _mm_shuffle_ps(v[k], v[k], 0x1B));
+                }
+            }
+            mapBlockScalar(src, columns, dst, m, r, r + 4, c, c1);
+        }
+        mapBlockScalar(src, columns, dst, m, r, r1, c0, c1);
+    }
+
+    SIMD_TARGET_AVX2 inline __m256 reverse8(__m256 v)
+    {
+        return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+
+    SIMD_TARGET_AVX2 void reverseRowAvx2(const float* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8 )
+            _mm256_storeu_ps(dst + count - 8 - i, reverse8(_mm256_loadu_ps(src + i)));
+        reverseRowScalar(src + i, dst, count - i);
+    }
+
+    SIMD_TARGET_AVX2 void transposeTileAvx2(const float* src, size_t columns, float* dst, const Mapping& m,
+                                            unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1)
+    {
+        unsigned int r = r0;
+        for( ; r + 8 <= r1; r += 8 )
+        {
+            unsigned int c = c0;
+            for( ; c + 8 <= c1; c += 8 )
+            {
+                __m256 v[8];
+                simdTranspose8x8(src + r * columns + c, columns, v);
+                for( int k = 0; k < 8; ++k )
+                {
+                    float* d = dst + m.base + (ptrdiff_t)(c + k) * m.colStep + (ptrdiff_t)r * m.rowStep;
+                    if( m.rowStep > 0 )
+                        _mm256_storeu_ps(d, v[k]);
+                    else
+                        _mm256_storeu_ps(d - 7, reverse8(v[k]));
+                }
+            }
+            mapBlockScalar(src, columns, dst, m, r, r + 8, c, c1);
+        }
+        mapBlockScalar(src, columns, dst, m, r, r1, c0, c1);
+    }
+
+    typedef void (*ReverseFunc)(const float*, float*, size_t);
+    typedef void (*TransposeFunc)(const float*, size_t, float*, const Mapping&, unsigned int, unsigned int, unsigned int, unsigned int);
+
+    const bool hasAvx2 = simdHasAvx2();
+    const bool hasSse41 = simdHasSse41();
+
+    const ReverseFunc reverseRow = hasAvx2 ? reverseRowAvx2 : hasSse41 ? reverseRowSse41 : reverseRowScalar;
+    const TransposeFunc transposeTile = hasAvx2 ? transposeTileAvx2 : hasSse41 ? transposeTileSse41 : transposeTileScalar;
+}
+
+FrameTransform::FrameTransform() : transformMode(NONE)
+{
+}
+
+FrameTransform::~FrameTransform()
+{
+}
+
+void FrameTransform::outputSize(unsigned int rows, unsigned int columns, unsigned int& out_rows, unsigned int& out_columns) const
+{
+    bool swap = swapsAxes(transform());
+    out_rows = swap ? columns : rows;
+    out_columns = swap ? rows : columns;
+}
+
+void FrameTransform::apply(eTransform transform, const float* src, unsigned int rows, unsigned int columns, float* dst)
+{
+    Mapping m = mappingOf(transform, rows, columns);
+    if( m.colStep == 1 || m.colStep == -1 )
+    {
+        // the rows stay rows: sequential copies, nothing to gain from tiles
+        for( unsigned int r = 0; r < rows; ++r )
+        {
+            const float* s = src + (size_t)r * columns;
+            float* d = dst + m.base + (ptrdiff_t)r * m.rowStep;
+            if( m.colStep == 1 )
+                std::copy(s, s + columns, d);
+            else
+                reverseRow(s, d - (columns - 1), columns);
+        }
+        return;
+    }
+
+    for( unsigned int r0 = 0; r0 < rows; r0 += TILE )
+        for( unsigned int c0 = 0; c0 < columns; c0 += TILE )
+            transposeTile(src, columns, dst, m, r0, std::min(r0 + TILE, rows), c0, std::min(c0 + TILE, columns));
+}
+
+void FrameTransform::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    eTransform t = transform();
+    if( t == NONE || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+    {
+        forward(frame);
+        return;
+    }
+
+    // the mode can change in between, use the one read above
+    unsigned int rows = swapsAxes(t) ? frame.columns() : frame.rows();
+    unsigned int columns = swapsAxes(t) ? frame.rows() : frame.columns();
+    float* output = outputBuffer((size_t)rows * columns);
+    apply(t, frame.data(), frame.rows(), frame.columns(), output);
+
+    NITLibrary::NITFrame transformed(frame.bitsPerPixel(), output, columns, rows,
+                                     frame.Id(), frame.temperature(), frame.gigeTimestamp());
+    forward(transformed);
+}
@@ -0,0 +1,287 @@
+#include "GainKernels.h"
+#include "SimdSupport.h"
+
+#include <cmath>
+
+namespace
+{
+    inline float gainScalar(float v, float scale, float offset)
+    {
+        v = v * scale + offset;
+        v = v < 0.0f ? 0.0f : v > 255.0f ? 255.0f : v;
+        // same round half to even as the SIMD conversion
+        return std::nearbyint(v);
+    }
+
+    void gainFloatScalar(float* pixels, size_t count, float scale, float offset)
+    {
+        for( size_t i = 0; i < count; ++i )
+            pixels[i] = gainScalar(pixels[i], scale, offset);
+    }
+
+    void gainFloatToUint8Scalar(const float* src, unsigned char* dst, size_t count, float scale, float offset)
+    {
+        for( size_t i = 0; i < count; ++i )
+            dst[i] = (unsigned char)gainScalar(src[i], scale, offset);
+    }
+
+    void gainUint16ToUint8Scalar(const unsigned short* src, unsigned char* dst, size_t count, float scale, float offset)
+    {
+        for( size_t i = 0; i < count; ++i )
+            dst[i] = (unsigned char)gainScalar((float)src[i], scale, offset);
+    }
+
+    inline unsigned int histogramBin(float v)
+    {
+        int bin = (int)v;
+        return bin < 0 ? 0u : bin > 16383 ? 16383u : (unsigned int)bin;
+    }
+
+    void accumulateHistogram14Scalar(const float* src, size_t count, size_t step, unsigned int* bins)
+    {
+        for( size_t i = 0; i < count; ++i )
+            ++bins[histogramBin(src[i * step])];
+    }
+
+    void applyGainOffsetScalar(float* pixels, const float* gain, const float* offset, size_t count)
+    {
+        for( size_t i = 0; i < count; ++i )
+            pixels[i] = pixels[i] * gain[i] + offset[i];
+    }
+
+    void subtractClampScalar(float* pixels, const float* dark, size_t count)
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            float v = pixels[i] - dark[i];
+            pixels[i] = v > 0.0f ? v : 0.0f;
+        }
+    }
+
+    SIMD_TARGET_SSE41 inline __m128 gainSse41(__m128 v, __m128 scale, __m128 offset)
+    {
+        v = _mm_add_ps(_mm_mul_ps(v, scale), offset);
+        return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    }
+
+    SIMD_TARGET_SSE41 void gainFloatSse41(float* pixels, size_t count, float scale, float offset)
+    {
+        const __m128 s = _mm_set1_ps(scale), o = _mm_set1_ps(offset);
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+        {
+            __m128 v = gainSse41(_mm_loadu_ps(pixels + i), s, o);
+            _mm_storeu_ps(pixels + i, _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        }
+        gainFloatScalar(pixels + i, count - i, scale, offset);
+    }
+
+    SIMD_TARGET_SSE41 void gainFloatToUint8Sse41(const float* src, unsigned char* dst, size_t count, float scale, float offset)
+    {
+        const __m128 s = _mm_set1_ps(scale), o = _mm_set1_ps(offset);
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m128i v[4];
+            for( int k = 0; k < 4; ++k )
+                v[k] = _mm_cvtps_epi32(gainSse41(_mm_loadu_ps(src + i + 4 * k), s, o));
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packus_epi32(v[0], v[1]), _mm_packus_epi32(v[2], v[3])));
+        }
+        gainFloatToUint8Scalar(src + i, dst + i, count - i, scale, offset);
+    }
+
+    SIMD_TARGET_SSE41 void gainUint16ToUint8Sse41(const unsigned short* src, unsigned char* dst, size_t count, float scale, float offset)
+    {
+        const __m128 s = _mm_set1_ps(scale), o = _mm_set1_ps(offset);
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 8));
+            __m128i w[4] = { _mm_cvtepu16_epi32(a), _mm_cvtepu16_epi32(_mm_srli_si128(a, 8)),
+                             _mm_cvtepu16_epi32(b), _mm_cvtepu16_epi32(_mm_srli_si128(b, 8)) };
+            __m128i v[4];
+            for( int k = 0; k < 4; ++k )
+                v[k] = _mm_cvtps_epi32(gainSse41(_mm_cvtepi32_ps(w[k]), s, o));
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packus_epi32(v[0], v[1]), _mm_packus_epi32(v[2], v[3])));
+        }
+        gainUint16ToUint8Scalar(src + i, dst + i, count - i, scale, offset);
+    }
+
+    SIMD_TARGET_SSE41 void applyGainOffsetSse41(float* pixels, const float* gain, const float* offset, size_t count)
+    {
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+        {
+            __m128 v = _mm_mul_ps(_mm_loadu_ps(pixels + i), _mm_loadu_ps(gain + i));
+            _mm_storeu_ps(pixels + i, _mm_add_ps(v, _mm_loadu_ps(offset + i)));
+        }
+        applyGainOffsetScalar(pixels + i, gain + i, offset + i, count - i);
+    }
+
+    SIMD_TARGET_SSE41 void subtractClampSse41(float* pixels, const float* dark, size_t count)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        size_t i = 0;
+        for( ; i + 4 <= count; i += 4 )
+            _mm_storeu_ps(pixels + i, _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(pixels + i), _mm_loadu_ps(dark + i)), zero));
+        subtractClampScalar(pixels + i, dark + i, count - i);
+    }
+
+    SIMD_TARGET_AVX2 inline __m256 gainAvx2(__m256 v, __m256 scale, __m256 offset)
+    {
+        v = _mm256_add_ps(_mm256_mul_ps(v, scale), offset);
+        return _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(255.0f));
+    }
+
+    SIMD_TARGET_AVX2 inline __m256i packAvx2(const __m256i v[4])
+    {
+        // packus works per 128 bit lane, put the dwords back in order
+        __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(v[0], v[1]), _mm256_packus_epi32(v[2], v[3]));
+        return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    }
+
+    SIMD_TARGET_AVX2 void gainFloatAvx2(float* pixels, size_t count, float scale, float offset)
+    {
+        const __m256 s = _mm256_set1_ps(scale), o = _mm256_set1_ps(offset);
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m256 a = gainAvx2(_mm256_loadu_ps(pixels + i), s, o);
+            __m256 b = gainAvx2(_mm256_loadu_ps(pixels + i + 8), s, o);
+            _mm256_storeu_ps(pixels + i, _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+            _mm256_storeu_ps(pixels + i + 8, _mm256_round_ps(b, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        }
+        gainFloatScalar(pixels + i, count - i, scale, offset);
+    }
+
+    SIMD_TARGET_AVX2 void gainFloatToUint8Avx2(const float* src, unsigned char* dst, size_t count, float scale, float offset)
+    {
+        const __m256 s = _mm256_set1_ps(scale), o = _mm256_set1_ps(offset);
+        size_t i = 0;
+        for( ; i + 32 <= count; i += 32 )
+        {
+            __m256i v[4];
+            for( int k = 0; k < 4; ++k )
+                v[k] = _mm256_cvtps_epi32(gainAvx2(_mm256_loadu_ps(src + i + 8 * k), s, o));
+            _mm256_storeu_si256((__m256i*)(dst + i), packAvx2(v));
+        }
+        gainFloatToUint8Scalar(src + i, dst + i, count - i, scale, offset);
+    }
+
+    SIMD_TARGET_AVX2 void gainUint16ToUint8Avx2(const unsigned short* src, unsigned char* dst, size_t count, float scale, float offset)
+    {
+        const __m256 s = _mm256_set1_ps(scale), o = _mm256_set1_ps(offset);
+        size_t i = 0;
+        for( ; i + 32 <= count; i += 32 )
+        {
+            __m256i v[4];
+            for( int k = 0; k < 4; ++k )
+            {
+                __m256i w = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i + 8 * k)));
+                v[k] = _mm256_cvtps_epi32(gainAvx2(_mm256_cvtepi32_ps(w), s, o));
+            }
+            _mm256_storeu_si256((__m256i*)(dst + i), packAvx2(v));
+        }
+        gainUint16ToUint8Scalar(src + i, dst + i, count - i, scale, offset);
+    }
+
+    SIMD_TARGET_AVX2 void accumulateHistogram14Avx2(const float* src, size_t count, size_t step, unsigned int* bins)
+    {
+        if( step != 1 )
+        {
+            // a gather costs more than the scalar loads
+            accumulateHistogram14Scalar(src, count, step, bins);
+            return;
+        }
+
+        // the bin indices are computed 16 at a time, only the increments stay scalar
+        const __m256i lo = _mm256_setzero_si256(), hi = _mm256_set1_epi32(16383);
+        alignas(32) unsigned int index[16];
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m256i a = _mm256_cvttps_epi32(_mm256_loadu_ps(src + i));
+            __m256i b = _mm256_cvttps_epi32(_mm256_loadu_ps(src + i + 8));
+            _mm256_store_si256((__m256i*)index, _mm256_min_epi32(_mm256_max_epi32(a, lo), hi));
+            _mm256_store_si256((__m256i*)(index + 8), _mm256_min_epi32(_mm256_max_epi32(b, lo), hi));
+            for( int k = 0; k < 16; ++k )
+                ++bins[index[k]];
+        }
+        accumulateHistogram14Scalar(src + i, count - i, 1, bins);
+    }
+
+    SIMD_TARGET_AVX2 void subtractClampAvx2(float* pixels, const float* dark, size_t count)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m256 a = _mm256_sub_ps(_mm256_loadu_ps(pixels + i), _mm256_loadu_ps(dark + i));
+            __m256 b = _mm256_sub_ps(_mm256_loadu_ps(pixels + i + 8), _mm256_loadu_ps(dark + i + 8));
+            _mm256_storeu_ps(pixels + i, _mm256_max_ps(a, zero));
+            _mm256_storeu_ps(pixels + i + 8, _mm256_max_ps(b, zero));
+        }
+        subtractClampScalar(pixels + i, dark + i, count - i);
+    }
+
+    SIMD_TARGET_FMA void applyGainOffsetFma(float* pixels, const float* gain, const float* offset, size_t count)
+    {
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m256 a = _mm256_fmadd_ps(_mm256_loadu_ps(pixels + i), _mm256_loadu_ps(gain + i), _mm256_loadu_ps(offset + i));
+            __m256 b = _mm256_fmadd_ps(_mm256_loadu_ps(pixels + i + 8), _mm256_loadu_ps(gain + i + 8), _mm256_loadu_ps(offset + i + 8));
+            _mm256_storeu_ps(pixels + i, a);
+            _mm256_storeu_ps(pixels + i + 8, b);
+        }
+        applyGainOffsetScalar(pixels + i, gain + i, offset + i, count - i);
+    }
+
+    typedef void (*GainFloatFunc)(float*, size_t, float, float);
+    typedef void (*GainFloatToUint8Func)(const float*, unsigned char*, size_t, float, float);
+    typedef void (*GainUint16ToUint8Func)(const unsigned short*, unsigned char*, size_t, float, float);
+    typedef void (*GainOffsetFunc)(float*, const float*, const float*, size_t);
+    typedef void (*SubtractFunc)(float*, const float*, size_t);
+    typedef void (*HistogramFunc)(const float*, size_t, size_t, unsigned int*);
+
+    const bool hasAvx2 = simdHasAvx2();
+    const bool hasSse41 = simdHasSse41();
+
+    const GainFloatFunc gainFloatImpl = hasAvx2 ? gainFloatAvx2 : hasSse41 ? gainFloatSse41 : gainFloatScalar;
+    const GainFloatToUint8Func gainFloatToUint8Impl = hasAvx2 ? gainFloatToUint8Avx2 : hasSse41 ? gainFloatToUint8Sse41 : gainFloatToUint8Scalar;
+    const GainUint16ToUint8Func gainUint16ToUint8Impl = hasAvx2 ? gainUint16ToUint8Avx2 : hasSse41 ? gainUint16ToUint8Sse41 : gainUint16ToUint8Scalar;
+    const GainOffsetFunc applyGainOffsetImpl = simdHasFma() ? applyGainOffsetFma : hasSse41 ? applyGainOffsetSse41 : applyGainOffsetScalar;
+    const SubtractFunc subtractClampImpl = hasAvx2 ? subtractClampAvx2 : hasSse41 ? subtractClampSse41 : subtractClampScalar;
+    const HistogramFunc accumulateHistogram14Impl = hasAvx2 ? accumulateHistogram14Avx2 : accumulateHistogram14Scalar;
+}
+
+void gainFloat(float* pixels, size_t count, float scale, float offset)
+{
+    gainFloatImpl(pixels, count, scale, offset);
+}
+
+void gainToUint8(const float* src, unsigned char* dst, size_t count, float scale, float offset)
+{
+    gainFloatToUint8Impl(src, dst, count, scale, offset);
+}
+
+void gainToUint8(const unsigned short* src, unsigned char* dst, size_t count, float scale, float offset)
+{
+    gainUint16ToUint8Impl(src, dst, count, scale, offset);
+}
+
+void applyGainOffset(float* pixels, const float* gain, const float* offset, size_t count)
+{
+    applyGainOffsetImpl(pixels, gain, offset, count);
+}
+
+void subtractClamp(float* pixels, const float* dark, size_t count)
+{
+    subtractClampImpl(pixels, dark, count);
+}
+
+void accumulateHistogram14(const float* src, size_t count, size_t step, unsigned int* bins)
+{
+    accumulateHistogram14Impl(src, count, step, bins);
+}
@@ -1,19 +1,26 @@
 #include "NITCam.h"
 #include <thread>
 #include <chrono>
-#include <ctime>
+#include <cmath>
+#include <algorithm>
 
 using namespace std;
 using namespace NITLibrary::NITToolBox;  //For the filters and observer
 
-NITCam::NITCam() : mgc(2000, 5000) {
+NITCam::NITCam() : NITCam(string()) {
+}
+
+NITCam::NITCam(const string serialNumber) : mgc(2000, 5000), captureTimeout(3000), configPending(false), softwareNuc(false), savedDeviceNuc(false), savedDeviceBpr(false), memoryColumnMajor(false), memorySingle(false), metadataSidecar(false), receivedBaseline(0), droppedBaseline(0), frameBufferOwner(0) {
 	pPlayer = NULL;
+	dev = NULL;
+	fill(statusBaseline, statusBaseline + CONFIG_OBSERVER::STATUS_CODES + 1, 0ULL);
+	fill(statisticsFields, statisticsFields + STATISTICS_FIELDS, 0.0);
 
 	//NITManualGainControl mgc(min, max);
 	try {
-		cout << "Connecting to device ..." << endl;
-		//Open a connection to the camera and create a NITDevice instance
-		dev = CreateDevice();    										
+		cout << "Connecting to device " << serialNumber << " ..." << endl;
+		//Open a connection to the camera and create a NITDevice instance, the first one without a serial number
+		dev = serialNumber.empty() ? CreateDevice() : CreateDevice(serialNumber);
 		
 		if (dev) {
 			//Connect a NITConfigObserver derived class to the NITDevice
@@ -23,6 +30,8 @@ NITCam::NITCam() : mgc(2000, 5000) {
 			ConfigureDevice(dev);										
 			// configure snap counter
 			snap.setCounter(1, 5);
+			// the filter graph lives as long as the device
+			buildPipeline();
 
 		} else {
 			cout << "No Camera on USB, so ... I'm out!!!" << std::endl;
@@ -35,19 +44,54 @@ NITCam::NITCam() : mgc(2000, 5000) {
 }
 
 NITCam::~NITCam() {
+	// a running asynchronous capture still uses the device
+	captureWorker.shutdown();
 	if (dev != NULL) {
-		// make sure to stop cam and delete player if still running
+		// make sure to stop cam if still running
 		stopLiveImage();
+		try {
+			snap.disconnect();
+			frameBuffer.disconnect();
+			metadata.disconnect();
+			fileMetadata.disconnect();
+			frameRing.disconnect();
+			sequenceRecorder.disconnect();
+			flatField.disconnect();
+			agc.disconnect();
+			transform.disconnectDownstream();
+			averager.disconnectDownstream();
+			averager.disconnect();
+			dark.disconnect();
+			nuc.disconnect();
+			statistics.disconnect();
+		}
+		catch (NITException& exc) {
+			cout << "NITException: " << exc.what() << std::endl;
+		}
+		// without the release the manager refuses to open the camera again, NITCamArray::close relies on it
+		try {
+			ReleaseDevice(dev);
+		}
+		catch (NITException& exc) {
+			cout << "NITException: " << exc.what() << std::endl;
+		}
+		dev = NULL;
+	}
+	if (pPlayer != NULL) {
+		delete pPlayer;
+		pPlayer = NULL;
 	}
 }
 
 void NITCam::activateTriggerMode(bool state) {
+	lock_guard<mutex> deviceLock(deviceMutex);
 	try {
+		// sent with the next updateConfig
 		if (state) {
-			dev->setParamValueOf("Trigger Mode", "Input");
+			setParam("Trigger Mode", "Input");
 		}
 		else {
-			dev->setParamValueOf("Trigger Mode", "Disabled");
+			setParam("Trigger Mode", "Disabled");
 		}
 	}
 	catch (NITException& exc) {
@@ -55,89 +99,783 @@ void NITCam::activateTriggerMode(bool state) {
 	}
 }
 
+bool NITCam::configure(bool gatedMode, double triggerDelayInput, double exposureTime) {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if (dev == NULL) {
+		return false;
+	}
+	try {
+		configureCapture(gatedMode, triggerDelayInput, exposureTime);
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+string NITCam::serialNumber() {
+	if (dev == NULL) {
+		return string();
+	}
+	return dev->serialNumber();
+}
+
+void NITCam::buildPipeline() {
+	// dev -> statistics -> nuc -> dark -> averager -> transform -> mgc -> agc -> { snap, frameBuffer, metadata tables, frameRing, sequenceRecorder, flatField, player }
+	// bit modes only switch the gain filters on and off, the sinks stay connected and idle until armed
+	// the averager is a relay: it decides which frames reach mgc and everything behind it
+	// the transform is a relay too, rotated frames don't have the dimensions of the frame they come from
+	// statistics sees every frame of the device, before the averager combines them
+	// it also stamps the frames as they enter the pipeline, the ring and the metadata take their host times from it
+	frameRing.attachArrivals(&statistics);
+	metadata.attachArrivals(&statistics);
+	fileMetadata.attachArrivals(&statistics);
+	*dev << statistics << nuc << dark;
+	dark << averager;
+	averager << transform;
+	transform << mgc;
+	mgc << agc;
+	agc << snap;
+	agc << frameBuffer;
+	agc << metadata;
+	agc << fileMetadata;
+	agc << frameRing;
+	agc << sequenceRecorder;
+	agc << flatField;
+	nuc.activate(false);
+	selectBitMode(0);
+}
+
+void NITCam::frameSize(unsigned int& rows, unsigned int& columns) {
+	// dimensions of the frames the sinks get
+	transform.outputSize((unsigned int)dev->paramValueOf("Number of Lines"), (unsigned int)dev->paramValueOf("NumberOfColumns"), rows, columns);
+}
+
+void NITCam::selectBitMode(int bitMode) {
+	// 0 = no gain control, 1 = mgc, everything else = agc
+	mgc.activate(bitMode == 1);
+	agc.activate(bitMode != 0 && bitMode != 1);
+}
+
+bool NITCam::setParam(const string& paramName, const string& value) {
+	if (config_observer.params().matches(paramName, value)) {
+		return false;
+	}
+	dev->setParamValueOf(paramName, value);
+	config_observer.params().request(paramName, value);
+	configPending = true;
+	return true;
+}
+
+bool NITCam::setParam(const string& paramName, double value) {
+	if (config_observer.params().matches(paramName, value)) {
+		return false;
+	}
+	dev->setParamValueOf(paramName, value);
+	config_observer.params().request(paramName, value);
+	configPending = true;
+	return true;
+}
+
+void NITCam::commitParams() {
+	if (configPending) {
+		try {
+			dev->updateConfig();
+		}
+		catch (NITException&) {
+			// the values may or may not have reached the device, write them again next time
+			config_observer.params().invalidatePending();
+			throw;
+		}
+		configPending = false;
+		config_observer.params().settle();
+	}
+}
+
+void NITCam::configureCapture(bool gatedMode, double inputTriggerDelay, double exposureTime) {
+	// only values that differ from the device are written
+	bool modeChanged;
+	if (gatedMode) {
+		modeChanged = setParam("Mode", "Gated");
+	} else {
+		modeChanged = setParam("Mode", "Global Shutter");
+		setParam("AnalogGain", "Low");
+	}
+	// a new mode changes the parameter ranges, so it has to reach the device first
+	if (modeChanged) {
+		commitParams();
+	}
+	setParam("Exposure Time", exposureTime);
+	setParam("Trigger Delay Input", inputTriggerDelay);
+	commitParams();
+	metadata.setSettings(gatedMode, inputTriggerDelay, exposureTime);
+	fileMetadata.setSettings(gatedMode, inputTriggerDelay, exposureTime);
+	// the table is swapped before the first frame of the capture
+	if (softwareNuc) {
+		selectNuc(gatedMode, exposureTime);
+	}
+}
+
+void NITCam::selectNuc(bool gatedMode, double exposureTime) {
+	int mode = gatedMode ? NUC_GATED : NUC_GLOBAL_SHUTTER;
+	if (nuc.selectExposure(exposureTime, mode)) {
+		if (!deviceNucSource.empty()) {
+			dev->activateNuc(false);
+			deviceNucSource.clear();
+		}
+		return;
+	}
+
+	// no table: the SDK interpolates from the directory of setNucDirectory, only reloaded when it changes
+	string source = nucDirectory;
+	if (source.empty()) {
+		cout << "No NUC table for exposure time " << exposureTime << ", frames are not corrected" << endl;
+		return;
+	}
+	if (source != deviceNucSource) {
+		cout << "No NUC table for exposure time " << exposureTime << ", using the SDK NUC " << source << endl;
+		dev->setNucDirectory(source);
+		dev->activateNuc(true);
+		deviceNucSource = source;
+	}
+}
+
 bool NITCam::captureFrames(const string saveDirectory, const string fileName, const string fileType, bool gatedMode, int bitMode, double inputTriggerDelay, double exposureTime, int numOfFramesToCapture) {
-	switch (bitMode) {
-		case 0:
-			// build pipelie without gc
-			*dev << snap;
-			break;
-		case 1:
-			// build pipeline with mgc
-			*dev << mgc << snap;
-			break;
-		default:
-			// build pipelie with agc
-			*dev << agc << snap;
+	// one capture at a time, an asynchronous capture finishes first
+	lock_guard<mutex> deviceLock(deviceMutex);
+	// one row per written frame, in file order
+	if (metadataSidecar) {
+		fileMetadata.arm(numOfFramesToCapture > 0 ? numOfFramesToCapture : 0);
 	}
-		
+	bool captured = false;
+	try {
+		selectBitMode(bitMode);
+
+		configureCapture(gatedMode, inputTriggerDelay, exposureTime);
+
+		if (fileType == "seq") {
+			captured = recordSequence(saveDirectory + "/" + fileName + ".seq", bitMode, numOfFramesToCapture);
+		}
+		else {
+			captured = recordSnapshots(saveDirectory, fileName, fileType, numOfFramesToCapture);
+		}
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+		captured = false;
+	}
+	// an exception can leave the snapshot armed and the recording open
+	snap.disarm();
+	if (sequenceRecorder.isOpen()) {
+		sequenceRecorder.close();
+	}
+	if (metadataSidecar) {
+		fileMetadata.disarm();
+		// written for failed captures too, the rows show which frames made it
+		string sidecarName = saveDirectory + "/" + fileName + ".meta";
+		if (fileMetadata.write(sidecarName)) {
+			cout << "Metadata File: " << sidecarName << std::endl;
+		}
+	}
+	return captured;
+}
+
+bool NITCam::captureFramesToMemory(bool gatedMode, int bitMode, double inputTriggerDelay, double exposureTime, int numOfFramesToCapture) {
+	return captureToFrameBuffer(gatedMode, bitMode, inputTriggerDelay, exposureTime, numOfFramesToCapture, 0);
+}
 
+bool NITCam::captureToFrameBuffer(bool gatedMode, int bitMode, double inputTriggerDelay, double exposureTime, int numOfFramesToCapture, unsigned int handle) {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if (numOfFramesToCapture <= 0) {
+		cout << "Nothing to capture.." << endl;
+		return false;
+	}
+	bool captured = false;
 	try {
-		// change mode to 'global shutter'
-		if (gatedMode) {
-			dev->setParamValueOf("Mode", "Gated");
-		} else {
-			dev->setParamValueOf("Mode", "Global Shutter");
-			dev->setParamValueOf("AnalogGain", "Low");
-		}
-		// needto update mode config first
-		dev->updateConfig();
-		dev->setParamValueOf("Exposure Time", exposureTime);
-		dev->setParamValueOf("Trigger Delay Input", inputTriggerDelay);
-		dev->updateConfig();
-
-		//cout << "setting filetype to *.bmp and directory to: " << directory << endl;
-		snap.reset(saveDirectory, fileName, fileType);
-		snap.setCounter(snap.getCounterValue(), 5);
-
-		// set snap count
-		snap.snap(numOfFramesToCapture);
-		// get current counter value
-		unsigned int currentCounterValue = snap.getCounterValue();
-		//cout << "Current counnter value: " << currentCounterValue << std::endl;
-		// start capturing
-		dev->start();
+		selectBitMode(bitMode);
+
+		configureCapture(gatedMode, inputTriggerDelay, exposureTime);
+
+		unsigned int rows, columns;
+		frameSize(rows, columns);
+		frameBuffer.arm(numOfFramesToCapture, rows, columns, memoryFormat(bitMode), memoryColumnMajor);
+		metadata.arm(numOfFramesToCapture);
+
+		chrono::steady_clock::time_point deadline;
+		captured = acquireFrames(numOfFramesToCapture, deadline)
+			&& waitForFrameBuffer(numOfFramesToCapture, deadline);
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+		captured = false;
+	}
+	frameBuffer.disarm();
+	metadata.disarm();
+	// synchronous captures are readable at once, asynchronous ones with fetch
+	frameBufferOwner = handle;
+	if (handle == 0) {
+		publishCapture();
+		sweepDelays.clear();
+	}
+	return captured;
+}
+
+bool NITCam::captureDelaySweep(bool gatedMode, int bitMode, const double* triggerDelays, const double* exposureTimes, const int* framesPerStep, int numSteps) {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if (numSteps <= 0) {
+		cout << "Nothing to capture.." << endl;
+		return false;
+	}
+	for (int step = 0; step < numSteps; step++) {
+		if (framesPerStep[step] <= 0) {
+			cout << "Step " << step << " has no frames to capture.." << endl;
+			return false;
+		}
+	}
+
+	bool captured = false;
+	try {
+		selectBitMode(bitMode);
+		configureCapture(gatedMode, triggerDelays[0], exposureTimes[0]);
+
+		unsigned int rows, columns;
+		frameSize(rows, columns);
+		frameBuffer.arm(numSteps, rows, columns, memoryFormat(bitMode), memoryColumnMajor);
+		// every frame of every step gets a row, with the delay and exposure of its step
+		unsigned int sweepFrames = 0;
+		for (int step = 0; step < numSteps; step++) {
+			sweepFrames += (unsigned int)framesPerStep[step];
+		}
+		metadata.arm(sweepFrames);
+
+		// USB only sends parameters on updateConfig, so the next step can be prepared while this one streams
+		// GIGE applies them immediately and has to wait for the end of the step
+		bool stageDuringCapture = dev->connectorType() != GIGE;
 
-		// wait until frame is captured
-		time_t tstart;
-		tstart = time(0);
-		while ((currentCounterValue + numOfFramesToCapture) > snap.getCounterValue()) {
-			// break if time limit reached
-			if (difftime(time(0), tstart) > 2) {
-				cout << "No frame within 3 seconds.." << endl;
-				return false;
+		captured = true;
+		for (int step = 0; captured && step < numSteps; step++) {
+			frameBuffer.setAveraging(framesPerStep[step]);
+
+			chrono::steady_clock::time_point deadline;
+			unsigned long long targetFrameCount = startAcquisition(framesPerStep[step], deadline);
+			if (stageDuringCapture && step + 1 < numSteps) {
+				setParam("Exposure Time", exposureTimes[step + 1]);
+				setParam("Trigger Delay Input", triggerDelays[step + 1]);
+			}
+			captured = finishAcquisition(targetFrameCount, deadline)
+				&& waitForFrameBuffer(step + 1, deadline);
+
+			if (captured && step + 1 < numSteps) {
+				if (!stageDuringCapture) {
+					setParam("Exposure Time", exposureTimes[step + 1]);
+					setParam("Trigger Delay Input", triggerDelays[step + 1]);
+				}
+				commitParams();
+				metadata.setSettings(gatedMode, triggerDelays[step + 1], exposureTimes[step + 1]);
+				// the next exposure time needs its own NUC table, as in configureCapture
+				if (softwareNuc) {
+					selectNuc(gatedMode, exposureTimes[step + 1]);
+				}
 			}
 		}
-		dev->stop();
+		if (!captured) {
+			cout << "Sweep stopped after " << frameBuffer.frames() << " of " << numSteps << " steps.." << endl;
+		}
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+		captured = false;
+	}
+	frameBuffer.disarm();
+	frameBuffer.setAveraging(1);
+	metadata.disarm();
+	frameBufferOwner = 0;
+	publishCapture();
+	sweepDelays.assign(triggerDelays, triggerDelays + numSteps);
+	return captured;
+}
+
+bool NITCam::reconstructRange(int method, float minIntensity) {
+	unsigned int steps = resultBuffer.frames();
+	if (steps == 0 || steps != sweepDelays.size()) {
+		cout << "No delay sweep in memory.." << endl;
+		return false;
+	}
+	RangeReconstruction::eMethod rangeMethod = method == 1 ? RangeReconstruction::CENTROID
+		: method == 2 ? RangeReconstruction::PARABOLIC : RangeReconstruction::PEAK;
+	rangeReconstruction.setMinIntensity(minIntensity);
+	// pixel by pixel: a column major stack gives column major maps
+	if (resultBuffer.format() == FrameBuffer::UINT8) {
+		return rangeReconstruction.compute(resultBuffer.data8(), steps, resultBuffer.rows(), resultBuffer.columns(), sweepDelays.data(), rangeMethod);
+	}
+	if (resultBuffer.format() == FrameBuffer::SINGLE) {
+		return rangeReconstruction.compute(resultBuffer.dataSingle(), steps, resultBuffer.rows(), resultBuffer.columns(), sweepDelays.data(), rangeMethod);
+	}
+	return rangeReconstruction.compute(resultBuffer.data16(), steps, resultBuffer.rows(), resultBuffer.columns(), sweepDelays.data(), rangeMethod);
+}
+
+const float* NITCam::rangeMap(size_t numel) {
+	if (numel != (size_t)rangeReconstruction.rows() * rangeReconstruction.columns()) {
+		cout << "No range map with " << numel << " pixels.." << endl;
+		return NULL;
+	}
+	return rangeReconstruction.range();
+}
+
+const float* NITCam::intensityMap(size_t numel) {
+	if (numel != (size_t)rangeReconstruction.rows() * rangeReconstruction.columns()) {
+		cout << "No intensity map with " << numel << " pixels.." << endl;
+		return NULL;
+	}
+	return rangeReconstruction.intensity();
+}
+
+unsigned int NITCam::capturedFrames() {
+	return resultBuffer.frames();
+}
+
+unsigned int NITCam::capturedRows() {
+	return resultBuffer.rows();
+}
+
+unsigned int NITCam::capturedColumns() {
+	return resultBuffer.columns();
+}
+
+const unsigned short* NITCam::frameData16(size_t numel) {
+	if (resultBuffer.format() != FrameBuffer::UINT16 || numel != resultBuffer.size()) {
+		cout << "No 14-bit capture with " << numel << " pixels in memory.." << endl;
+		return NULL;
+	}
+	return resultBuffer.data16();
+}
+
+const unsigned char* NITCam::frameData8(size_t numel) {
+	if (resultBuffer.format() != FrameBuffer::UINT8 || numel != resultBuffer.size()) {
+		cout << "No 8-bit capture with " << numel << " pixels in memory.." << endl;
+		return NULL;
+	}
+	return resultBuffer.data8();
+}
+
+const float* NITCam::frameDataSingle(size_t numel) {
+	if (resultBuffer.format() != FrameBuffer::SINGLE || numel != resultBuffer.size()) {
+		cout << "No single capture with " << numel << " pixels in memory.." << endl;
+		return NULL;
+	}
+	return resultBuffer.dataSingle();
+}
+
+unsigned int NITCam::metadataFrames() {
+	return resultMetadata.frames();
+}
+
+const unsigned long long* NITCam::metadataIds(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.ids();
+}
+
+const double* NITCam::metadataHostTimes(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.hostTimes();
+}
+
+const float* NITCam::metadataTemperatures(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.temperatures();
+}
 
+const double* NITCam::metadataTimestamps(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.timestamps();
+}
+
+const double* NITCam::metadataExposureTimes(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.exposureTimes();
+}
+
+const double* NITCam::metadataTriggerDelays(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.triggerDelays();
+}
+
+const unsigned char* NITCam::metadataGatedModes(size_t numel) {
+	if (numel != resultMetadata.frames()) {
+		cout << "No metadata of " << numel << " frames in memory.." << endl;
+		return NULL;
+	}
+	return resultMetadata.gatedModes();
+}
+
+bool NITCam::writeMetadata(const string fileName) {
+	return resultMetadata.write(fileName);
+}
+
+void NITCam::setMetadataSidecar(bool state) {
+	metadataSidecar = state;
+}
+
+void NITCam::setMemoryFormat(bool columnMajor, bool singlePrecision) {
+	if (columnMajor && transform.transform() == FrameTransform::TRANSPOSE) {
+		cout << "The frames are transposed already (setTransform(4)), a column major memory would transpose them back.." << endl;
+		return;
+	}
+	memoryColumnMajor = columnMajor;
+	memorySingle = singlePrecision;
+}
+
+FrameBuffer::ePixelFormat NITCam::memoryFormat(int bitMode) {
+	if (memorySingle) {
+		return FrameBuffer::SINGLE;
+	}
+	return bitMode != 0 ? FrameBuffer::UINT8 : FrameBuffer::UINT16;
+}
+
+void NITCam::publishCapture() {
+	// the frames just captured become the readable ones, the old buffer is filled by the next capture
+	frameBuffer.swap(resultBuffer);
+	metadata.swap(resultMetadata);
+}
+
+int NITCam::startCapture(bool gatedMode, int bitMode, double triggerDelayInput, double exposureTime, int numOfFramesToCapture) {
+	if (numOfFramesToCapture <= 0) {
+		cout << "Nothing to capture.." << endl;
+		return 0;
+	}
+	unsigned int handle = captureWorker.start([this, gatedMode, bitMode, triggerDelayInput, exposureTime, numOfFramesToCapture](unsigned int job) {
+		return captureToFrameBuffer(gatedMode, bitMode, triggerDelayInput, exposureTime, numOfFramesToCapture, job);
+	});
+	if (handle == 0) {
+		cout << "The last capture is still running.." << endl;
+	}
+	return (int)handle;
+}
+
+bool NITCam::isDone(int handle) {
+	return handle > 0 && captureWorker.isDone((unsigned int)handle);
+}
+
+bool NITCam::wait(int handle, int timeoutMs) {
+	return handle > 0 && captureWorker.wait((unsigned int)handle, timeoutMs);
+}
+
+bool NITCam::fetch(int handle) {
+	bool captured = false;
+	if (handle <= 0 || !captureWorker.result((unsigned int)handle, captured)) {
+		cout << "Capture " << handle << " is unknown or was fetched already.." << endl;
+		return false;
+	}
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if ((unsigned int)handle != frameBufferOwner) {
+		cout << "The frames of capture " << handle << " were replaced by a later capture.." << endl;
+		return false;
+	}
+	frameBufferOwner = 0;
+	publishCapture();
+	sweepDelays.clear();
+	return captured;
+}
+
+bool NITCam::acquireFrames(int numOfFrames, chrono::steady_clock::time_point& deadline) {
+	unsigned long long targetFrameCount = startAcquisition(numOfFrames, deadline);
+	return finishAcquisition(targetFrameCount, deadline);
+}
+
+unsigned long long NITCam::startAcquisition(int numOfFrames, chrono::steady_clock::time_point& deadline) {
+	// block averaging needs N camera frames per captured frame, and the blocks start with the capture
+	numOfFrames = (int)averager.inputFrames(numOfFrames);
+	averager.reset();
+
+	// nominal acquisition time plus the configured timeout
+	double fps = dev->fps();
+	chrono::milliseconds nominal(fps > 0 ? (long long)(numOfFrames * 1000.0 / fps) : 0);
+	deadline = chrono::steady_clock::now() + nominal + chrono::milliseconds(captureTimeout);
+
+	unsigned long long targetFrameCount = config_observer.receivedFrames() + numOfFrames;
+	statistics.restartStream();
+	dev->captureNFrames(numOfFrames);
+	return targetFrameCount;
+}
+
+bool NITCam::finishAcquisition(unsigned long long targetFrameCount, const chrono::steady_clock::time_point& deadline) {
+	// waitEndCapture stops the streaming if it times out
+	int remaining = (int)chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+	if (!dev->waitEndCapture(remaining > 0 ? remaining : 0)) {
+		cout << "No frames before the capture deadline.." << endl;
+		return false;
+	}
+	// make sure every frame has been handed to the pipeline
+	remaining = (int)chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+	if (!config_observer.waitForFrames(targetFrameCount, remaining > 0 ? remaining : 0)) {
+		cout << "Frame counter did not reach " << targetFrameCount << " in time.." << endl;
+		return false;
+	}
+	return true;
+}
+
+bool NITCam::waitForFrameBuffer(unsigned int slots, const chrono::steady_clock::time_point& deadline) {
+	// the buffer is filled in the pipeline thread, give it the rest of the deadline to catch up
+	if (frameBuffer.waitForFrames(slots, deadline)) {
+		return true;
+	}
+	if (frameBuffer.droppedFrames() > 0) {
+		cout << frameBuffer.droppedFrames() << " frames had an unexpected size and were dropped.." << endl;
+	}
+	else {
+		cout << "Frame buffer did not receive all frames in time.." << endl;
+	}
+	return false;
+}
+
+bool NITCam::recordSnapshots(const string& saveDirectory, const string& fileName, const string& fileType, int numOfFrames) {
+	//cout << "setting filetype to *.bmp and directory to: " << directory << endl;
+	snap.reset(saveDirectory, fileName, fileType);
+	snap.setCounter(snap.getCounterValue(), 5);
+
+	// set snap count, the snapshot writes nothing outside of this capture
+	snap.arm(numOfFrames);
+	// get current counter value
+	unsigned int currentCounterValue = snap.getCounterValue();
+	//cout << "Current counnter value: " << currentCounterValue << std::endl;
+	// capture and block until the frames went through the device
+	chrono::steady_clock::time_point deadline;
+	bool captured = acquireFrames(numOfFrames, deadline);
+
+	// the snapshot writes in its own pipeline thread, give it the rest of the deadline to catch up
+	if (captured && !snap.waitForCounter(currentCounterValue + numOfFrames, deadline)) {
+		cout << "Snapshot did not write all frames in time.." << endl;
+		captured = false;
+	}
+	snap.disarm();
+
+	if (captured) {
 		cout << "Last File Name: " << snap.getLastFileName() << std::endl;
 	}
+	return captured;
+}
+
+bool NITCam::recordSequence(const string& fileName, int bitMode, int numOfFrames) {
+	if (numOfFrames <= 0) {
+		cout << "Nothing to capture.." << endl;
+		return false;
+	}
+	unsigned int rows, columns;
+	frameSize(rows, columns);
+	if (!sequenceRecorder.open(fileName, numOfFrames, rows, columns, bitMode != 0)) {
+		return false;
+	}
+
+	chrono::steady_clock::time_point deadline;
+	bool captured = acquireFrames(numOfFrames, deadline);
+	// the recorder packs the frames in the pipeline thread, give it the rest of the deadline to catch up
+	if (captured && !sequenceRecorder.waitForFrames(numOfFrames, deadline)) {
+		cout << "Sequence recorder did not receive all frames in time.." << endl;
+		captured = false;
+	}
+	if (sequenceRecorder.droppedFrames() > 0) {
+		cout << sequenceRecorder.droppedFrames() << " frames were dropped while recording.." << endl;
+		captured = false;
+	}
+
+	captured = sequenceRecorder.close() && captured;
+	cout << "Sequence File: " << fileName << std::endl;
+	return captured;
+}
+
+bool NITCam::startFrameRing(unsigned int slotCount, int bitMode) {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if (slotCount == 0) {
+		cout << "The frame ring needs at least one slot.." << endl;
+		return false;
+	}
+	try {
+		dev->stop();
+		frameRing.enable(false);
+		selectBitMode(bitMode);
+		commitParams();
+
+		unsigned int rows, columns;
+		frameSize(rows, columns);
+		frameRing.allocate(slotCount, rows, columns, bitMode != 0);
+		frameRing.enable(true);
+		statistics.restartStream();
+		dev->start();
+	}
 	catch (NITException& exc) {
 		cout << "NITException: " << exc.what() << std::endl;
+		frameRing.enable(false);
 		return false;
 	}
-	// disconnect all
-	snap.disconnect();
-	agc.disconnect();
-	mgc.disconnect();
 	return true;
 }
 
+void NITCam::stopFrameRing() {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	try {
+		dev->stop();
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+	}
+	// queued frames stay readable
+	frameRing.enable(false);
+}
+
+unsigned int NITCam::ringAvailable() {
+	return frameRing.available();
+}
+
+unsigned long long NITCam::ringOverflows() {
+	return frameRing.overflows();
+}
+
+const unsigned short* NITCam::ringFrameData16(size_t numel) {
+	const FrameRing::Slot* slot = frameRing.front();
+	if (slot == NULL || frameRing.eightBit() || numel != slot->pixels16.size()) {
+		cout << "No queued 14-bit frame with " << numel << " pixels.." << endl;
+		return NULL;
+	}
+	return slot->pixels16.data();
+}
+
+const unsigned char* NITCam::ringFrameData8(size_t numel) {
+	const FrameRing::Slot* slot = frameRing.front();
+	if (slot == NULL || !frameRing.eightBit() || numel != slot->pixels8.size()) {
+		cout << "No queued 8-bit frame with " << numel << " pixels.." << endl;
+		return NULL;
+	}
+	return slot->pixels8.data();
+}
+
+unsigned long long NITCam::ringFrameId() {
+	const FrameRing::Slot* slot = frameRing.front();
+	return slot != NULL ? slot->id : 0;
+}
+
+float NITCam::ringFrameTemperature() {
+	const FrameRing::Slot* slot = frameRing.front();
+	return slot != NULL ? slot->temperature : 0.0f;
+}
+
+double NITCam::ringFrameTimestamp() {
+	const FrameRing::Slot* slot = frameRing.front();
+	return slot != NULL ? slot->timestamp : 0.0;
+}
+
+void NITCam::releaseRingFrame() {
+	frameRing.pop();
+}
+
+void NITCam::connectObserver(NITObserver& observer) {
+	agc << observer;
+}
+
+const double* NITCam::statisticsSnapshot(size_t numel) {
+	if (numel != STATISTICS_FIELDS) {
+		cout << "The statistics have " << STATISTICS_FIELDS << " fields.." << endl;
+		return NULL;
+	}
+	FrameStatistics::Snapshot snapshot = statistics.snapshot();
+	statisticsFields[0] = (double)snapshot.frames;
+	statisticsFields[1] = (double)snapshot.gaps;
+	statisticsFields[2] = (double)snapshot.missingFrames;
+	statisticsFields[3] = (double)snapshot.largestGap;
+	statisticsFields[4] = (double)snapshot.idResets;
+	statisticsFields[5] = (double)snapshot.lastId;
+	statisticsFields[6] = snapshot.meanInterval;
+	statisticsFields[7] = snapshot.jitter;
+	statisticsFields[8] = snapshot.minInterval;
+	statisticsFields[9] = snapshot.maxInterval;
+	statisticsFields[10] = (double)(config_observer.receivedFrames() - receivedBaseline);
+	statisticsFields[11] = (double)(config_observer.droppedFrames() - droppedBaseline);
+	return statisticsFields;
+}
+
+unsigned long long NITCam::statusCount(int status) {
+	int slot = status >= 0 && status < CONFIG_OBSERVER::STATUS_CODES ? status : CONFIG_OBSERVER::STATUS_CODES;
+	return config_observer.statusCount(status) - statusBaseline[slot];
+}
+
+void NITCam::resetStatistics() {
+	statistics.reset();
+	// the device counters run since the connection, count from their current values
+	receivedBaseline = config_observer.receivedFrames();
+	droppedBaseline = config_observer.droppedFrames();
+	for (int status = 0; status < CONFIG_OBSERVER::STATUS_CODES; status++) {
+		statusBaseline[status] = config_observer.statusCount(status);
+	}
+	statusBaseline[CONFIG_OBSERVER::STATUS_CODES] = config_observer.statusCount(-1);
+}
+
+void NITCam::setCaptureTimeout(int milliseconds) {
+	captureTimeout = milliseconds > 0 ? milliseconds : 0;
+}
+
 void NITCam::setMgcMinMax(unsigned short min, unsigned short max) {
 	mgc.setMinMaxValue(min, max);
 	//*dev << mgc << snap;
 }
 
+void NITCam::setAgcOptions(int subsample, double smoothing, int refreshInterval, double sceneChange) {
+	agc.setSubsample(subsample > 1 ? subsample : 1);
+	agc.setTemporalFilter((float)smoothing, refreshInterval > 1 ? refreshInterval : 1, (float)sceneChange);
+}
+
+void NITCam::setAgcRoi(unsigned short xLeft, unsigned short xRight, unsigned short yTop, unsigned short yBottom) {
+	agc.setRoi(Roi(xLeft, xRight, yTop, yBottom));
+}
+
+void NITCam::setAveraging(int mode, double parameter) {
+	FrameAverager::eMode averageMode = mode == 1 ? FrameAverager::RUNNING_MEAN
+		: mode == 2 ? FrameAverager::EMA : mode == 3 ? FrameAverager::BLOCK : FrameAverager::OFF;
+	averager.setMode(averageMode, parameter);
+}
+
+void NITCam::setTransform(int mode) {
+	if (mode == FrameTransform::TRANSPOSE && memoryColumnMajor) {
+		cout << "The memory captures are column major already (setMemoryFormat), a transpose would turn them back.." << endl;
+		return;
+	}
+	transform.setTransform(mode >= 1 && mode <= 6 ? (FrameTransform::eTransform)mode : FrameTransform::NONE);
+}
+
 void NITCam::startLiveImage() {
+	startPlayer(2);
+}
+
+void NITCam::startPlayer(int bitMode) {
+	lock_guard<mutex> deviceLock(deviceMutex);
 	// Make sure no player is running
-	stopLiveImage();
-	// allocate new instance of none existing
+	stopStreaming();
+	// the player window is created once and reused
 	if (pPlayer == NULL) {
 		pPlayer = new NITPlayer("Camera view");
 	}
 
 	try {
-		snap.disconnect();
-		*dev << agc << *pPlayer;
+		selectBitMode(bitMode);
+		agc << *pPlayer;
+		statistics.restartStream();
 		dev->start();
 	}
 	catch (NITException& exc) {
@@ -151,31 +889,20 @@ void NITCam::startLiveImage() {
 }
 
 void NITCam::startMgcLiveImage() {
-	// Make sure no player is running
-	stopLiveImage();
-	// reset pipeline
-	if (pPlayer == NULL) {
-		pPlayer = new NITPlayer("Camera view");
-	}
-	try {
-		snap.disconnect();
-		*dev << mgc << *pPlayer;
-		dev->start();
-	}
-	catch (NITException& exc) {
-		cout << "NITException: " << exc.what() << std::endl;
-	}
+	startPlayer(1);
 }
 
 void NITCam::stopLiveImage() {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	stopStreaming();
+}
+
+void NITCam::stopStreaming() {
 	try {
 		dev->stop();
-		snap.disconnect();
-		agc.disconnect();
-		mgc.disconnect();
+		// only the player leaves the pipeline, the window stays for the next live view
 		if (pPlayer != NULL) {
-			delete pPlayer;
-			pPlayer = NULL;
+			pPlayer->disconnect();
 		}
 	}
 	catch (NITException& exc) {
@@ -186,15 +913,45 @@ void NITCam::stopLiveImage() {
 void NITCam::setNucDirectory(const string nucFileDirectory) {
 	try {
 		dev->setNucDirectory(nucFileDirectory);
+		// the software NUC falls back to this directory for the exposures without a table
+		nucDirectory = nucFileDirectory;
+		if (softwareNuc) {
+			savedNucSource = nucFileDirectory;
+		} else {
+			deviceNucSource = nucFileDirectory;
+		}
 	}
 	catch (NITException& exc) {
 		cout << "NITException: " << exc.what() << std::endl;
 	}
 }
 
+int NITCam::loadNucTables(const string tableDirectory) {
+	// the SDK never sees this directory, it keeps the NUC of the last setNucDirectory / setNucFile
+	vector<string> files = listNucFiles(tableDirectory);
+	int cached = 0;
+	for (size_t i = 0; i < files.size(); i++) {
+		NucFileInfo info;
+		shared_ptr<NucTable> table = readNucFile(files[i], info);
+		if (table && info.exposureTime >= 0.0) {
+			nuc.addTable(info.exposureTime, table, info.mode);
+			cached++;
+		} else {
+			cout << "NUC file " << files[i] << " can't be read, ignored.." << endl;
+		}
+	}
+	cout << "NUC: " << cached << " of " << files.size() << " tables loaded from " << tableDirectory << endl;
+	return cached;
+}
+
 void NITCam::setNucFile(const string nucFileDirectory) {
 	try {
 		dev->setNucFile(nucFileDirectory);
+		if (softwareNuc) {
+			savedNucSource = nucFileDirectory;
+		} else {
+			deviceNucSource = nucFileDirectory;
+		}
 	}
 	catch (NITException& exc) {
 		cout << "NITException: " << exc.what() << std::endl;
@@ -253,3 +1010,264 @@ void NITCam::bprActive() {
 	}
 }
 
+void NITCam::useSoftwareNuc(bool state) {
+	try {
+		if (state && !softwareNuc) {
+			savedDeviceNuc = dev->nucActive();
+			savedDeviceBpr = dev->bprActive();
+			savedNucSource = deviceNucSource;
+			dev->activateNuc(false);
+			dev->activateBpr(false);
+			deviceNucSource.clear();
+		}
+		else if (!state && softwareNuc) {
+			// selectNuc may have handed the SDK another file in the meantime
+			if (!savedNucSource.empty() && savedNucSource != deviceNucSource) {
+				if (savedNucSource == nucDirectory) {
+					dev->setNucDirectory(savedNucSource);
+				} else {
+					dev->setNucFile(savedNucSource);
+				}
+			}
+			deviceNucSource = savedNucSource;
+			dev->activateNuc(savedDeviceNuc);
+			dev->activateBpr(savedDeviceBpr);
+		}
+		nuc.activate(state);
+		softwareNuc = state;
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+	}
+}
+
+bool NITCam::addNucTable(double exposureTime, int rows, int columns, const float* gain, const float* offset, const unsigned char* badPixels, int numel) {
+	if (rows <= 0 || columns <= 0 || numel != rows * columns) {
+		cout << "addNucTable: numel must be rows * columns" << endl;
+		return false;
+	}
+	nuc.addTable(exposureTime, make_shared<NucTable>(rows, columns, gain, offset, badPixels));
+	return true;
+}
+
+void NITCam::clearNucTables() {
+	nuc.clearTables();
+}
+
+bool NITCam::captureNucLowPoints(bool gatedMode, double triggerDelayInput, const double* exposureTimes, int numExposures, int framesPerPoint, double rejectSigma) {
+	return captureNucPoints(false, gatedMode, triggerDelayInput, exposureTimes, numExposures, framesPerPoint, rejectSigma);
+}
+
+bool NITCam::captureNucHighPoints(bool gatedMode, double triggerDelayInput, const double* exposureTimes, int numExposures, int framesPerPoint, double rejectSigma) {
+	return captureNucPoints(true, gatedMode, triggerDelayInput, exposureTimes, numExposures, framesPerPoint, rejectSigma);
+}
+
+bool NITCam::captureNucPoints(bool high, bool gatedMode, double triggerDelayInput, const double* exposureTimes, int numExposures, int framesPerPoint, double rejectSigma) {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if (numExposures <= 0 || framesPerPoint <= 0) {
+		cout << "Nothing to capture.." << endl;
+		return false;
+	}
+
+	// the flat fields are taken on raw frames, the corrections are restored afterwards
+	bool restoreSoftwareNuc = softwareNuc;
+	bool restoreDeviceNuc = false, restoreDeviceBpr = false;
+	bool restoreDark = dark.active();
+	// the flat fields are in sensor orientation, like the frames the NUC corrects
+	FrameTransform::eTransform restoreTransform = transform.transform();
+	// every raw frame is a sample of the flat field, an averaged one would shrink the standard deviation
+	FrameAverager::eMode restoreAveraging = averager.mode();
+	double restoreAveragingParameter = averager.parameter();
+	bool captured = true;
+	try {
+		averager.setMode(FrameAverager::OFF, 0.0);
+		restoreDeviceNuc = dev->nucActive();
+		restoreDeviceBpr = dev->bprActive();
+		dev->activateNuc(false);
+		dev->activateBpr(false);
+		nuc.activate(false);
+		softwareNuc = false;
+		dark.activate(false);
+		transform.setTransform(FrameTransform::NONE);
+		selectBitMode(0);
+
+		vector<float> mean, stddev;
+		for (int i = 0; captured && i < numExposures; i++) {
+			configureCapture(gatedMode, triggerDelayInput, exposureTimes[i]);
+
+			unsigned int rows = (unsigned int)dev->paramValueOf("Number of Lines");
+			unsigned int columns = (unsigned int)dev->paramValueOf("NumberOfColumns");
+			flatField.arm(framesPerPoint, rows, columns, (float)rejectSigma);
+
+			chrono::steady_clock::time_point deadline;
+			captured = acquireFrames(framesPerPoint, deadline)
+				&& waitForFlatField(framesPerPoint, deadline);
+			flatField.disarm();
+
+			if (captured) {
+				flatField.result(mean, stddev);
+				nucCalibration.setPoint(exposureTimes[i], gatedMode ? NUC_GATED : NUC_GLOBAL_SHUTTER, high, rows, columns, mean, stddev);
+				cout << (high ? "High" : "Low") << " point of exposure time " << exposureTimes[i] << ": "
+					<< flatField.rejectedSamples() << " outlier samples rejected" << endl;
+			}
+		}
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+		captured = false;
+	}
+	flatField.disarm();
+
+	try {
+		dev->activateNuc(restoreDeviceNuc);
+		dev->activateBpr(restoreDeviceBpr);
+		nuc.activate(restoreSoftwareNuc);
+		softwareNuc = restoreSoftwareNuc;
+		dark.activate(restoreDark);
+		transform.setTransform(restoreTransform);
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+	}
+	averager.setMode(restoreAveraging, restoreAveragingParameter);
+	return captured;
+}
+
+bool NITCam::waitForFlatField(unsigned int frames, const chrono::steady_clock::time_point& deadline) {
+	// the accumulator runs in the pipeline thread, give it the rest of the deadline
+	if (flatField.waitForFrames(frames, deadline)) {
+		return true;
+	}
+	if (flatField.droppedFrames() > 0) {
+		cout << flatField.droppedFrames() << " frames had an unexpected size and were dropped.." << endl;
+	}
+	else {
+		cout << "Flat field did not receive all frames in time.." << endl;
+	}
+	return false;
+}
+
+int NITCam::writeNucCalibration(const string directory) {
+	vector<double> exposures;
+	vector<int> modes;
+	nucCalibration.completePoints(exposures, modes);
+	if (exposures.empty()) {
+		cout << "No exposure time has a low and a high point.." << endl;
+		return 0;
+	}
+
+	// the tables are in the NITCam format, not in a NUC subdirectory the SDK would read
+	CreateDirectoryA(directory.c_str(), NULL);
+
+	int written = 0;
+	NucCalibration::Result result;
+	for (size_t i = 0; i < exposures.size(); i++) {
+		if (!nucCalibration.compute(exposures[i], modes[i], result)) {
+			cout << "NUC of exposure time " << exposures[i] << " can't be computed, is the high flat field brighter than the low one?" << endl;
+			continue;
+		}
+		NucFileInfo info;
+		info.exposureTime = exposures[i];
+		info.mode = modes[i];
+		info.path = directory + "/" + nucFileName(exposures[i], modes[i]);
+		if (writeNucFile(info, result.rows, result.columns, result.gain.data(), result.offset.data(), result.badPixels.data())) {
+			cout << "NUC File: " << info.path << " (" << result.badPixelCount << " bad pixels)" << endl;
+			written++;
+		}
+	}
+	if (written > 0) {
+		loadNucTables(directory);
+	}
+	return written;
+}
+
+bool NITCam::captureDarkFrame(bool gatedMode, double triggerDelayInput, double exposureTime, int numOfFrames, bool disableTrigger) {
+	lock_guard<mutex> deviceLock(deviceMutex);
+	if (numOfFrames <= 0) {
+		cout << "Nothing to capture.." << endl;
+		return false;
+	}
+
+	bool captured = false;
+	bool wasActive = dark.active();
+	FrameTransform::eTransform restoreTransform = transform.transform();
+	// the reference is the mean of raw frames, not of averaged ones
+	FrameAverager::eMode restoreAveraging = averager.mode();
+	double restoreAveragingParameter = averager.parameter();
+	string triggerMode;
+	float triggerValue;
+	bool restoreTrigger = false;
+	try {
+		// a trigger mode set with activateTriggerMode may still be queued, the restored mode has to be the real one
+		commitParams();
+		restoreTrigger = disableTrigger && config_observer.params().lookup("Trigger Mode", triggerMode, triggerValue);
+
+		// the reference is taken on the frames the subtraction will see: after the NUC, without gain control or transform
+		dark.activate(false);
+		transform.setTransform(FrameTransform::NONE);
+		averager.setMode(FrameAverager::OFF, 0.0);
+		selectBitMode(0);
+		if (disableTrigger) {
+			setParam("Trigger Mode", "Disabled");
+		}
+		configureCapture(gatedMode, triggerDelayInput, exposureTime);
+
+		unsigned int rows = (unsigned int)dev->paramValueOf("Number of Lines");
+		unsigned int columns = (unsigned int)dev->paramValueOf("NumberOfColumns");
+		flatField.arm(numOfFrames, rows, columns, 0.0f);
+
+		chrono::steady_clock::time_point deadline;
+		captured = acquireFrames(numOfFrames, deadline)
+			&& waitForFlatField(numOfFrames, deadline);
+		flatField.disarm();
+
+		if (captured) {
+			vector<float> mean, stddev;
+			flatField.result(mean, stddev);
+			dark.setReference(rows, columns, mean.data());
+			cout << "Dark frame of " << numOfFrames << " frames captured" << endl;
+		}
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+		captured = false;
+	}
+	flatField.disarm();
+
+	try {
+		if (restoreTrigger) {
+			setParam("Trigger Mode", triggerMode);
+			commitParams();
+		}
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+	}
+	dark.activate(captured || wasActive);
+	transform.setTransform(restoreTransform);
+	averager.setMode(restoreAveraging, restoreAveragingParameter);
+	return captured;
+}
+
+bool NITCam::setDarkFrame(const float* darkFrame, int rows, int columns, int numel) {
+	if (rows <= 0 || columns <= 0 || numel != rows * columns) {
+		cout << "setDarkFrame: numel must be rows * columns" << endl;
+		return false;
+	}
+	dark.setReference(rows, columns, darkFrame);
+	return true;
+}
+
+const float* NITCam::darkFrame(size_t numel) {
+	unsigned int rows, columns;
+	const float* reference = dark.reference(rows, columns);
+	if (reference == NULL || numel != (size_t)rows * columns) {
+		cout << "No dark frame with " << numel << " pixels.." << endl;
+		return NULL;
+	}
+	return reference;
+}
+
+void NITCam::activateDarkFrame(bool state) {
+	dark.activate(state);
+}
@@ -8,12 +8,33 @@
 #include <NITDevice.h>
 #include <NITFilter.h>
 #include <NITAutomaticGainControl.h>
-#include <NITManualGainControl.h>
+#include "Common/FastManualGainControl.h"
+#include "Common/FastAutomaticGainControl.h"
+#include "Common/NucFilter.h"
+#include "Common/NucFile.h"
+#include "Common/NucCalibration.h"
+#include "Common/FlatFieldAccumulator.h"
+#include "Common/FrameAverager.h"
+#include "Common/FrameTransform.h"
+#include "Common/DarkFrameFilter.h"
 #include <NITPlayer.h>
 #include <string>
+#include <chrono>
+#include <vector>
+#include <mutex>
 #include <NITSnapshot.h>
 
 #include "Common\CameraSelector.h"
+#include "Common/FrameBuffer.h"
+#include "Common/FrameMetadataTable.h"
+#include "Common/RangeReconstruction.h"
+#include "Common/FrameRing.h"
+#include "Common/FrameStatistics.h"
+#include "Common/SequenceRecorder.h"
+#include "Common/SnapshotWriter.h"
+#include "Common/SequenceReader.h"
+#include "Common/CaptureWorker.h"
+#include "Common/CameraDevice.h"
 
 #ifndef CAMERA_MODEL
     #error you must define CAMERA_MODEL in CameraSelector.h.
@@ -39,6 +60,11 @@ using namespace NITLibrary::NITToolBox;  //For the filters and observer
     #else
         #include "Common/ColorPipeline.h"
     #endif // NEED_AGC
+
+#elif defined(USE_SIMULATED)
+    #include "Common/CreateSimulatedDevice.h"
+    #include "Common/UsbConfigObserver.h"
+    #define CONFIG_OBSERVER UsbConfigObserver
 #endif
 
 /** \brief This is the main Interface Class to handle the shitty NIT Camera
@@ -47,34 +73,335 @@ using namespace NITLibrary::NITToolBox;  //For the filters and observer
  *
  */
 class NITCam {
-	NITSnapshot snap;
-	NITAutomaticGainControl agc;
-	NITManualGainControl mgc;
+	FrameStatistics statistics;
+	SnapshotWriter snap;
+	FastAutomaticGainControl agc;
+	FastManualGainControl mgc;
+	NucFilter nuc;
+	DarkFrameFilter dark;
+	FrameAverager averager;
+	FrameTransform transform;
+	FrameBuffer frameBuffer;
+	// frames of the last finished capture, frameBuffer is swapped in when a capture is published
+	FrameBuffer resultBuffer;
+	// one row per frame of the capture in frameBuffer / resultBuffer, swapped with them
+	FrameMetadataTable metadata;
+	FrameMetadataTable resultMetadata;
+	// rows of the file captures, written next to the files
+	FrameMetadataTable fileMetadata;
+	RangeReconstruction rangeReconstruction;
+	FrameRing frameRing;
+	SequenceRecorder sequenceRecorder;
+	FlatFieldAccumulator flatField;
+	NucCalibration nucCalibration;
 	
 	
 	//double numOfFramesToCapture;
 	
+	// extra time in ms granted on top of the nominal acquisition time
+	int captureTimeout;
+
+	// true if setParam queued values that updateConfig has not sent yet
+	bool configPending;
+
+	// true if the NUC runs in the nuc filter instead of the device
+	bool softwareNuc;
+	// directory of the last setNucDirectory, the SDK NUC of the exposures without a software table
+	string nucDirectory;
+	// NUC file or directory currently given to the SDK, empty if the SDK NUC is off
+	string deviceNucSource;
+	// device NUC and BPR before useSoftwareNuc(true), restored by useSoftwareNuc(false)
+	bool savedDeviceNuc, savedDeviceBpr;
+	string savedNucSource;
+
+	void selectNuc(bool gatedMode, double exposureTime);
+	bool waitForFlatField(unsigned int frames, const chrono::steady_clock::time_point& deadline);
+	bool captureNucPoints(bool high, bool gatedMode, double triggerDelayInput, const double* exposureTimes, int numExposures, int framesPerPoint, double rejectSigma);
+
+	bool setParam(const string& paramName, const string& value);
+	bool setParam(const string& paramName, double value);
+	void commitParams();
+
+	void buildPipeline();
+	void frameSize(unsigned int& rows, unsigned int& columns);
+	void selectBitMode(int bitMode);
+	void startPlayer(int bitMode);
+	void stopStreaming();
+	void configureCapture(bool gatedMode, double triggerDelayInput, double exposureTime);
+	bool acquireFrames(int numOfFrames, chrono::steady_clock::time_point& deadline);
+	unsigned long long startAcquisition(int numOfFrames, chrono::steady_clock::time_point& deadline);
+	bool finishAcquisition(unsigned long long targetFrameCount, const chrono::steady_clock::time_point& deadline);
+	bool waitForFrameBuffer(unsigned int slots, const chrono::steady_clock::time_point& deadline);
+	bool recordSnapshots(const string& saveDirectory, const string& fileName, const string& fileType, int numOfFrames);
+	bool recordSequence(const string& fileName, int bitMode, int numOfFrames);
+
+	// trigger delays of the last delay sweep, one per slice
+	vector<double> sweepDelays;
+
+	// layout and pixel class of the memory captures, see setMemoryFormat
+	bool memoryColumnMajor;
+	bool memorySingle;
+	FrameBuffer::ePixelFormat memoryFormat(int bitMode);
+
+	// true if captureFrames writes a .meta file next to the images or sequence
+	bool metadataSidecar;
+
+	// fields returned by statisticsSnapshot and the device counters at the last resetStatistics
+	static const int STATISTICS_FIELDS = 12;
+	double statisticsFields[STATISTICS_FIELDS];
+	unsigned long long receivedBaseline, droppedBaseline;
+	unsigned long long statusBaseline[CONFIG_OBSERVER::STATUS_CODES + 1];
+
+	// asynchronous captures run on captureWorker, every capture holds deviceMutex
+	CaptureWorker captureWorker;
+	mutex deviceMutex;
+	// handle of the asynchronous capture whose frames wait in frameBuffer, 0 if none (guarded by deviceMutex)
+	unsigned int frameBufferOwner;
+	bool captureToFrameBuffer(bool gatedMode, int bitMode, double triggerDelayInput, double exposureTime, int numOfFramesToCapture, unsigned int handle);
+	void publishCapture();
+
 	protected:
 		NITPlayer* pPlayer;
 	
 	public:
 		NITCam();
+		/** \brief Connect to the camera with the given serial number instead of the first one */
+		NITCam(const string serialNumber);
 		~NITCam();		
 		CONFIG_OBSERVER config_observer;
-		NITDevice* dev;
+		CameraDevice* dev;
 		// NITPlayer player;
 		
 		string directory;
 
 		void activateTriggerMode(bool);
+		/** \brief Set the mode, trigger delay and exposure time of the following captures without capturing */
+		bool configure(bool gatedMode, double triggerDelayInput, double exposureTime);
+		/** \brief Serial number of the connected camera, empty if there is none */
+		string serialNumber();
 		/** \brief Main function to capture frames
 		 *
 		 * int bitMode: 0 = 14-bit, 1 = 8-bit manual gain control, 2 = 8-bit automatic gain control
+		 * fileType "seq" records all frames into the single file saveDirectory/fileName.seq (uint16 for bitMode 0,
+		 * uint8 otherwise, see readNITSequence.m) instead of one image file per frame.
 		 *
 		 */
 		bool captureFrames(const string saveDirectory, const string fileName, const string fileType, bool gatedMode, int bitMode, double triggerDelayInput, double exposureTime, int numOfFramesToCapture);						// Expo Min: 100 - Expo Max: 2500 - step: 100;
 		
+		/** \brief Capture frames into memory instead of files
+		 *
+		 * Same parameters as captureFrames. The frames are kept in one contiguous buffer (frames x rows x columns, row major)
+		 * as uint16 for bitMode 0 and uint8 for bitMode 1 and 2. Use frameData16 / frameData8 to get them into MATLAB.
+		 *
+		 */
+		bool captureFramesToMemory(bool gatedMode, int bitMode, double triggerDelayInput, double exposureTime, int numOfFramesToCapture);
+
+		/** \brief Start a memory capture on a background thread and return at once
+		 *
+		 * Same parameters as captureFramesToMemory. Returns a handle (> 0), or 0 if the last capture is still running.
+		 * The frames go into a second preallocated buffer: capturedFrames and frameData16 / frameData8 / frameDataSingle
+		 * keep returning the previous capture until fetch is called. Other captures wait for a running one to finish and
+		 * replace its unfetched frames. Don't change camera settings while a capture runs.
+		 *
+		 */
+		int startCapture(bool gatedMode, int bitMode, double triggerDelayInput, double exposureTime, int numOfFramesToCapture);
+		/** \brief True once the capture of handle has finished */
+		bool isDone(int handle);
+		/** \brief Wait at most timeoutMs milliseconds (negative: no limit) for the capture, true if it has finished */
+		bool wait(int handle, int timeoutMs);
+		/** \brief Wait for the capture and make its frames the captured ones
+		 *
+		 * Returns the result of the capture, false as well if the handle was fetched already or its frames were replaced.
+		 *
+		 */
+		bool fetch(int handle);
+
+		/** \brief Capture a trigger delay sweep into memory
+		 *
+		 * For each of the numSteps steps the trigger delay and exposure time are set and framesPerStep frames are averaged
+		 * into one slice of a delay x rows x columns volume. Read it with capturedFrames (= steps) and frameData16 / frameData8.
+		 * Only the parameters that change between steps are sent to the camera.
+		 *
+		 */
+		bool captureDelaySweep(bool gatedMode, int bitMode, const double* triggerDelays, const double* exposureTimes, const int* framesPerStep, int numSteps);
+
+		/** \brief Compute per-pixel range and peak intensity from the last delay sweep
+		 *
+		 * int method: 0 = peak step, 1 = centroid, 2 = parabolic fit
+		 * Pixels with a peak below minIntensity get NaN as range.
+		 *
+		 */
+		bool reconstructRange(int method, float minIntensity);
+		/** \brief Return the range map in metres (rows x columns, row major) */
+		const float* rangeMap(size_t numel);
+		/** \brief Return the peak intensity map (rows x columns, row major) */
+		const float* intensityMap(size_t numel);
+
+		unsigned int capturedFrames();
+		unsigned int capturedRows();
+		unsigned int capturedColumns();
+
+		/** \brief Return the pixels of the last 14-bit memory capture
+		 *
+		 * numel must be capturedFrames() * capturedRows() * capturedColumns(), else NULL is returned.
+		 *
+		 */
+		const unsigned short* frameData16(size_t numel);
+		/** \brief Return the pixels of the last 8-bit memory capture
+		 *
+		 * numel must be capturedFrames() * capturedRows() * capturedColumns(), else NULL is returned.
+		 *
+		 */
+		const unsigned char* frameData8(size_t numel);
+		/** \brief Return the pixels of the last memory capture stored as single, see setMemoryFormat
+		 *
+		 * numel must be capturedFrames() * capturedRows() * capturedColumns(), else NULL is returned.
+		 *
+		 */
+		const float* frameDataSingle(size_t numel);
+
+		/** \brief Choose the layout and class of the following memory captures and delay sweeps
+		 *
+		 * columnMajor: each frame is stored column major, the MATLAB layout. reshape(data, capturedRows, capturedColumns, frames)
+		 * gives the images without a permute, the conversion and the transpose run in one pass as the frames arrive.
+		 * The range and intensity maps of a column major sweep are column major as well.
+		 * columnMajor is refused while setTransform(4) is active, the two would transpose twice.
+		 * singlePrecision: the pixels are kept as single (frameDataSingle) instead of uint16 (bitMode 0) or uint8, so
+		 * averaged sweep steps keep their fractions.
+		 *
+		 */
+		void setMemoryFormat(bool columnMajor, bool singlePrecision);
+
+		/** \brief Number of frames described by the metadata of the last memory capture or delay sweep
+		 *
+		 * Every frame that reached the memory gets one row: its Id, the host receive time, the sensor temperature and
+		 * timestamp and the settings it was taken with. In a sweep each averaged frame has its own row. Gaps in the Ids
+		 * show dropped frames. Each column is read with its own function, numel must be metadataFrames().
+		 *
+		 */
+		unsigned int metadataFrames();
+		const unsigned long long* metadataIds(size_t numel);
+		/** \brief Host times the frames entered the pipeline, seconds on the monotonic clock, only differences are meaningful */
+		const double* metadataHostTimes(size_t numel);
+		const float* metadataTemperatures(size_t numel);
+		const double* metadataTimestamps(size_t numel);
+		/** \brief Requested exposure times in us */
+		const double* metadataExposureTimes(size_t numel);
+		/** \brief Requested trigger delays in us */
+		const double* metadataTriggerDelays(size_t numel);
+		/** \brief 1 for gated frames, 0 for global shutter */
+		const unsigned char* metadataGatedModes(size_t numel);
+		/** \brief Write the metadata of the last memory capture to a binary sidecar, see readNITMetadata.m */
+		bool writeMetadata(const string fileName);
+		/** \brief Write saveDirectory/fileName.meta next to the files of each following captureFrames */
+		void setMetadataSidecar(bool state);
+
+		/** \brief Stream continuously into a ring of slotCount preallocated frames
+		 *
+		 * The streaming thread never waits for the consumer, frames arriving while the ring is full are dropped
+		 * and counted in ringOverflows(). Read the oldest frame with ringFrameData16 (bitMode 0) or
+		 * ringFrameData8 (gain controlled modes) and ringFrameId and release it
+		 * with releaseRingFrame.
+		 *
+		 */
+		bool startFrameRing(unsigned int slotCount, int bitMode);
+		void stopFrameRing();
+		unsigned int ringAvailable();
+		unsigned long long ringOverflows();
+		/** \brief Return the pixels of the oldest queued frame (rows x columns, row major)
+		 *
+		 * NULL if the ring is empty or holds the other pixel type.
+		 *
+		 */
+		const unsigned short* ringFrameData16(size_t numel);
+		const unsigned char* ringFrameData8(size_t numel);
+		unsigned long long ringFrameId();
+		float ringFrameTemperature();
+		double ringFrameTimestamp();
+		/** \brief Hand the oldest queued frame back to the ring */
+		void releaseRingFrame();
+		/** \brief Direct access for C++ consumers */
+		FrameRing& ring() { return frameRing; }
+		/** \brief Connect a C++ observer next to the capture sinks (after the gain control)
+		 *
+		 * It sees every frame the capture functions see. Disconnect it with observer.disconnect().
+		 *
+		 */
+		void connectObserver(NITObserver& observer);
+
+		/** \brief Snapshot of the stream statistics since the last resetStatistics
+		 *
+		 * numel must be 12. The fields are: 1 frames that reached the pipeline, 2 gaps in the frame Ids,
+		 * 3 frames missing in the gaps, 4 largest gap, 5 Id resets, 6 last frame Id, 7 mean frame interval (ms),
+		 * 8 interval jitter (standard deviation, ms), 9 min and 10 max interval (ms), 11 frames the device reported as
+		 * received and 12 as dropped. Intervals and gaps between two captures are not counted. The snapshot is taken
+		 * without blocking the stream and can be polled while streaming.
+		 *
+		 */
+		const double* statisticsSnapshot(size_t numel);
+		/** \brief Frames the device reported with this status since the last resetStatistics, 0 = ok */
+		unsigned long long statusCount(int status);
+		void resetStatistics();
+		/** \brief Direct access for C++ consumers */
+		FrameStatistics& frameStatistics() { return statistics; }
+
+		/** \brief Set the capture timeout in milliseconds
+		 *
+		 * The timeout is added to the nominal acquisition time (frames / fps), so long captures don't time out.
+		 *
+		 */
+		void setCaptureTimeout(int milliseconds);
+
 		void setMgcMinMax(unsigned short min, unsigned short max);
+
+		/** \brief Tune the automatic gain control (bitMode 2)
+		 *
+		 * int subsample: histogram on every n-th row and column, 1 = every pixel
+		 * double smoothing: weight of the new min/max in the running values, 1 = no smoothing
+		 * int refreshInterval: frames between two histograms, 1 = every frame
+		 * double sceneChange: change of the mean level, as a fraction of max - min, that forces a new histogram at once
+		 *
+		 */
+		void setAgcOptions(int subsample, double smoothing, int refreshInterval, double sceneChange);
+		/** \brief Build the automatic gain control histogram on a region only, all zeros = full frame **/
+		void setAgcRoi(unsigned short xLeft, unsigned short xRight, unsigned short yTop, unsigned short yBottom);
+
+		/** \brief Average frames in the stream, before the gain controls, captures and live view
+		 *
+		 * int mode: 0 = off, 1 = running mean since the capture started, 2 = exponential moving average, 3 = blocks of N frames
+		 * double parameter: alpha (0..1] for mode 2, N for mode 3
+		 * In mode 3 the captures ask the camera for N times the requested frames and get one mean per block.
+		 * The average restarts with every capture.
+		 *
+		 */
+		void setAveraging(int mode, double parameter);
+
+		/** \brief Flip, rotate or transpose the frames in the stream, before the gain controls, captures and live view
+		 *
+		 * int mode: 0 = off, 1 = flip horizontal, 2 = flip vertical, 3 = rotate 180, 4 = transpose, 5 = rotate 90 clockwise,
+		 * 6 = rotate 90 counterclockwise
+		 * Modes 4 to 6 swap capturedRows and capturedColumns. Mode 4 transposes the image itself, in the live view and the files
+		 * too; for column major memory captures of the sensor image use setMemoryFormat(true, ...) instead. Both together
+		 * would transpose twice: mode 4 is refused while column major memory captures are set, and the other way round.
+		 * The automatic gain control region is taken in transformed coordinates. NUC and dark frame captures are not transformed.
+		 *
+		 */
+		void setTransform(int mode);
+
+		/** \brief Capture the dark reference subtracted from the following frames
+		 *
+		 * numOfFrames frames are averaged with the given settings, with disableTrigger the trigger input is switched off
+		 * during the capture (no laser pulse) and restored afterwards. The subtraction runs after the NUC and before
+		 * averaging and gain control, values below 0 are clamped. The reference is rounded to whole levels.
+		 *
+		 */
+		bool captureDarkFrame(bool gatedMode, double triggerDelayInput, double exposureTime, int numOfFrames, bool disableTrigger);
+		/** \brief Use a dark reference captured earlier, numel = rows * columns (row major) **/
+		bool setDarkFrame(const float* darkFrame, int rows, int columns, int numel);
+		/** \brief Current dark reference, NULL if numel doesn't match **/
+		const float* darkFrame(size_t numel);
+		/** \brief Switch the dark frame subtraction on and off, the reference is kept **/
+		void activateDarkFrame(bool state);
 		
 		//void setAutomaticgainControl(bool);
 
@@ -84,7 +411,20 @@ class NITCam {
 
 		// ToDo: NUC and BPR, 
 
+		/** \brief Hand the directory of the NUC files to the SDK
+		 *
+		 * With the software NUC on, the SDK applies it to the exposures without a table.
+		 *
+		 */
 		void setNucDirectory(const string nucFileDirectory);
+		/** \brief Preload the NUC tables written by writeNucCalibration
+		 *
+		 * Every .yml table of the directory (or of its NUC subdirectory) is read once and kept in memory, indexed by exposure
+		 * time and gated/global shutter mode, and added to the tables already loaded. The directory is not handed to the SDK.
+		 * The tables are only used once useSoftwareNuc(true) is called. Returns the number of tables loaded.
+		 *
+		 */
+		int loadNucTables(const string tableDirectory);
 		void setNucFile(const string nucFileDirectory);
 
 		void setBprDirectory(const string bprFileDirectory);
@@ -96,6 +436,43 @@ class NITCam {
 		void nucActive();
 		void bprActive();
 
+		/** \brief Correct the frames in software instead of the device
+		 *
+		 * The device NUC and BPR are switched off and each capture uses the table added with addNucTable or loadNucTables for
+		 * its exposure time. Exposures without a table get the SDK NUC of the setNucDirectory directory, if any, else they
+		 * are not corrected.
+		 * useSoftwareNuc(false) gives the device back the NUC source and the NUC and BPR state it had before.
+		 *
+		 */
+		void useSoftwareNuc(bool state);
+		/** \brief Add the software NUC table of one exposure time
+		 *
+		 * gain, offset and badPixels hold rows x columns values (row major), numel = rows * columns.
+		 * corrected = raw * gain + offset, pixels with a non zero badPixels value are replaced by the mean of their good neighbours.
+		 *
+		 */
+		bool addNucTable(double exposureTime, int rows, int columns, const float* gain, const float* offset, const unsigned char* badPixels, int numel);
+		void clearNucTables();
+
+		/** \brief Capture the low flat field of each exposure time for the NUC calibration
+		 *
+		 * Point the camera at a uniform dark (or cold) scene first. For each exposure time framesPerPoint raw frames are
+		 * averaged per pixel without storing them; samples further than rejectSigma standard deviations from the running mean
+		 * of their pixel are left out (0 keeps every sample). NUC and gain controls are off during the capture.
+		 *
+		 */
+		bool captureNucLowPoints(bool gatedMode, double triggerDelayInput, const double* exposureTimes, int numExposures, int framesPerPoint, double rejectSigma);
+		/** \brief Capture the high flat field of each exposure time, same as captureNucLowPoints with a uniform bright scene **/
+		bool captureNucHighPoints(bool gatedMode, double triggerDelayInput, const double* exposureTimes, int numExposures, int framesPerPoint, double rejectSigma);
+		/** \brief Compute the NUC of every exposure time with a low and a high point
+		 *
+		 * One NUCFactory_<mode>_<exposure>us.yml per exposure is written into directory, then the directory is loaded
+		 * with loadNucTables; call useSoftwareNuc(true) to correct the frames with it. The files are not in the SDK format:
+		 * use a directory of their own and never give it to setNucDirectory. Returns the number of files written.
+		 *
+		 */
+		int writeNucCalibration(const string directory);
+
 };
 
 #endif
@@ -0,0 +1,336 @@
+#include "NITCamArray.h"
+#include <thread>
+#include <algorithm>
+
+NITCamArray::NITCamArray() : alignedId(0), alignedBase(0), alignedAny(false), unalignedCount(0), reanchorCount(0), nominalPeriod(0.0), framePeriod(0.0), checkArrivals(true), reanchored(false) {
+}
+
+NITCamArray::~NITCamArray() {
+	close();
+}
+
+bool NITCamArray::forEachCamera(const function<bool(NITCam&)>& task) {
+	// one thread per camera: each camera waits on its own device, not on the others
+	vector<char> succeeded(cameras.size(), 0);
+	vector<thread> workers;
+	for (size_t i = 0; i < cameras.size(); ++i) {
+		workers.emplace_back([&task, &succeeded, this, i] { succeeded[i] = task(*cameras[i]) ? 1 : 0; });
+	}
+	for (size_t i = 0; i < workers.size(); ++i) {
+		workers[i].join();
+	}
+	return find(succeeded.begin(), succeeded.end(), 0) == succeeded.end();
+}
+
+void NITCamArray::resetAlignment() {
+	lastIds.assign(cameras.size(), 0);
+	lastIndices.assign(cameras.size(), 0);
+	hasIndex.assign(cameras.size(), false);
+	originIds.assign(cameras.size(), 0);
+	hasOrigin.assign(cameras.size(), false);
+	alignedId = 0;
+	alignedBase = 0;
+	alignedAny = false;
+	unalignedCount = 0;
+	reanchorCount = 0;
+	nominalPeriod = 0.0;
+	framePeriod = 0.0;
+	checkArrivals = true;
+	reanchored = false;
+}
+
+unsigned long long NITCamArray::frameIndex(size_t camera, const FrameRing::Slot& slot) {
+	if (!hasIndex[camera]) {
+		lastIds[camera] = slot.id;
+		lastIndices[camera] = slot.id;
+		hasIndex[camera] = true;
+		return slot.id;
+	}
+	if (slot.id == lastIds[camera]) {
+		return lastIndices[camera];
+	}
+	// the ring keeps the frames in order, a lower Id means the counter rolled over at the next power of two
+	unsigned long long step = slot.id - lastIds[camera];
+	if (slot.id < lastIds[camera]) {
+		unsigned long long modulus = 1;
+		while (modulus != 0 && modulus <= lastIds[camera]) {
+			modulus <<= 1;
+		}
+		step = modulus - lastIds[camera] + slot.id;
+	}
+	if (camera == 0) {
+		// consecutive frames of the first camera give the trigger period
+		if (step == 1) {
+			double interval = chrono::duration<double>(slot.received - lastReceived).count();
+			if (interval > 0.0 && (framePeriod == 0.0 || interval < framePeriod)) {
+				framePeriod = interval;
+			}
+		}
+		lastReceived = slot.received;
+	}
+	lastIds[camera] = slot.id;
+	lastIndices[camera] += step;
+	return lastIndices[camera];
+}
+
+bool NITCamArray::arrivalsAgree() {
+	double period = framePeriod > 0.0 ? framePeriod : nominalPeriod;
+	if (!checkArrivals || period <= 0.0 || cameras.size() < 2) {
+		return true;
+	}
+
+	chrono::steady_clock::time_point latest = cameras[0]->ring().front()->received;
+	for (size_t i = 1; i < cameras.size(); ++i) {
+		latest = max(latest, cameras[i]->ring().front()->received);
+	}
+	// the frames of one trigger enter the pipelines within the host jitter, a quarter period is left for it
+	chrono::steady_clock::time_point bound = latest - chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(0.75 * period));
+	bool agree = true;
+	for (size_t i = 0; i < cameras.size(); ++i) {
+		if (cameras[i]->ring().front()->received < bound) {
+			agree = false;
+		}
+	}
+	if (agree) {
+		reanchored = false;
+		return true;
+	}
+	if (reanchored) {
+		cout << "The cameras stay more than 3/4 of a frame apart after re-anchoring, a constant skew: the arrival check is off until the next arm.." << endl;
+		checkArrivals = false;
+		reanchored = false;
+		return true;
+	}
+
+	// drop the frames that entered early, the next fronts become the origins
+	bool complete = true;
+	for (size_t i = 0; i < cameras.size(); ++i) {
+		FrameRing& ring = cameras[i]->ring();
+		unsigned long long dropped = 0;
+		while (ring.front() != NULL && ring.front()->received < bound) {
+			frameIndex(i, *ring.front());
+			ring.pop();
+			++dropped;
+		}
+		if (dropped > 0) {
+			cout << "Camera " << serials[i] << " is " << dropped << " frame(s) behind the Id alignment, re-anchoring.." << endl;
+			unalignedCount += dropped;
+		}
+		if (ring.front() == NULL) {
+			// the rest is dropped by the next call, the re-anchoring isn't done yet
+			complete = false;
+		}
+	}
+	// the aligned Ids keep counting from where they are
+	alignedBase = alignedAny ? alignedId + 1 : 0;
+	hasOrigin.assign(cameras.size(), false);
+	++reanchorCount;
+	reanchored = complete;
+	return false;
+}
+
+int NITCamArray::open(const string serialNumbers) {
+	close();
+
+	vector<string> requested;
+	size_t begin = 0;
+	while (begin <= serialNumbers.size()) {
+		size_t end = serialNumbers.find(',', begin);
+		if (end == string::npos) {
+			end = serialNumbers.size();
+		}
+		string serial = serialNumbers.substr(begin, end - begin);
+		serial.erase(0, serial.find_first_not_of(" \t"));
+		serial.erase(serial.find_last_not_of(" \t") + 1);
+		if (!serial.empty()) {
+			requested.push_back(serial);
+		}
+		begin = end + 1;
+	}
+	// the discovery runs here, before the threads open the devices
+	vector<string> discovered;
+	try {
+		discovered = DiscoverSerialNumbers();
+	}
+	catch (NITException& exc) {
+		cout << "NITException: " << exc.what() << std::endl;
+	}
+	if (requested.empty()) {
+		requested = discovered;
+	}
+	if (requested.empty()) {
+		cout << "No camera to open.." << endl;
+		return 0;
+	}
+
+	// connecting and configuring a camera takes seconds, all of them are opened at the same time
+	vector<NITCam*> opened(requested.size(), NULL);
+	vector<thread> workers;
+	for (size_t i = 0; i < requested.size(); ++i) {
+		workers.emplace_back([&opened, &requested, i] {
+			// NITCam only catches NITException, anything else would end the process from this thread
+			try {
+				opened[i] = new NITCam(requested[i]);
+			}
+			catch (std::exception& exc) {
+				cout << "Exception: " << exc.what() << std::endl;
+			}
+			catch (...) {
+				cout << "Unknown exception.." << std::endl;
+			}
+		});
+	}
+	for (size_t i = 0; i < workers.size(); ++i) {
+		workers[i].join();
+	}
+
+	for (size_t i = 0; i < opened.size(); ++i) {
+		if (opened[i] == NULL || opened[i]->dev == NULL) {
+			cout << "Camera " << requested[i] << " could not be opened.." << endl;
+			delete opened[i];
+			continue;
+		}
+		cameras.push_back(opened[i]);
+		serials.push_back(requested[i]);
+	}
+	resetAlignment();
+	return (int)cameras.size();
+}
+
+void NITCamArray::close() {
+	// ~NITCam releases the device, the same serial numbers can be opened again
+	for (size_t i = 0; i < cameras.size(); ++i) {
+		delete cameras[i];
+	}
+	cameras.clear();
+	serials.clear();
+	resetAlignment();
+}
+
+unsigned int NITCamArray::cameraCount() {
+	return (unsigned int)cameras.size();
+}
+
+string NITCamArray::serialNumber(unsigned int index) {
+	return index < serials.size() ? serials[index] : string();
+}
+
+NITCam& NITCamArray::camera(unsigned int index) {
+	return *cameras.at(index);
+}
+
+bool NITCamArray::configure(bool gatedMode, double triggerDelayInput, double exposureTime) {
+	if (cameras.empty()) {
+		return false;
+	}
+	return forEachCamera([gatedMode, triggerDelayInput, exposureTime](NITCam& cam) {
+		return cam.configure(gatedMode, triggerDelayInput, exposureTime);
+	});
+}
+
+bool NITCamArray::arm(unsigned int slotCount, int bitMode) {
+	if (cameras.empty()) {
+		return false;
+	}
+	resetAlignment();
+	bool armed = forEachCamera([slotCount, bitMode](NITCam& cam) {
+		// the trigger mode is sent with the parameters committed by startFrameRing
+		cam.activateTriggerMode(true);
+		return cam.startFrameRing(slotCount, bitMode);
+	});
+	if (!armed) {
+		cout << "Not every camera could be armed.." << endl;
+		disarm();
+		return false;
+	}
+	// checks the first aligned frames until the trigger period is measured
+	double fps = cameras[0]->dev->fps();
+	nominalPeriod = fps > 0 ? 1.0 / fps : 0.0;
+	return true;
+}
+
+void NITCamArray::disarm() {
+	forEachCamera([](NITCam& cam) {
+		cam.stopFrameRing();
+		return true;
+	});
+}
+
+bool NITCamArray::nextAlignedFrames() {
+	if (cameras.empty()) {
+		return false;
+	}
+	for (;;) {
+		// the latest front decides, every other camera has missed the frames before it
+		unsigned long long latest = 0;
+		for (size_t i = 0; i < cameras.size(); ++i) {
+			const FrameRing::Slot* slot = cameras[i]->ring().front();
+			if (slot == NULL) {
+				return false;
+			}
+			unsigned long long index = frameIndex(i, *slot);
+			if (!hasOrigin[i]) {
+				originIds[i] = index;
+				hasOrigin[i] = true;
+			}
+			latest = max(latest, index - originIds[i]);
+		}
+
+		bool aligned = true;
+		for (size_t i = 0; i < cameras.size(); ++i) {
+			const FrameRing::Slot* slot = cameras[i]->ring().front();
+			if (frameIndex(i, *slot) - originIds[i] < latest) {
+				cameras[i]->ring().pop();
+				++unalignedCount;
+				aligned = false;
+			}
+		}
+		if (aligned && arrivalsAgree()) {
+			alignedId = alignedBase + latest;
+			alignedAny = true;
+			return true;
+		}
+	}
+}
+
+unsigned long long NITCamArray::alignedFrameId() {
+	return alignedId;
+}
+
+const unsigned short* NITCamArray::alignedFrameData16(unsigned int index, size_t numel) {
+	if (index >= cameras.size()) {
+		cout << "No camera " << index << ".." << endl;
+		return NULL;
+	}
+	return cameras[index]->ringFrameData16(numel);
+}
+
+const unsigned char* NITCamArray::alignedFrameData8(unsigned int index, size_t numel) {
+	if (index >= cameras.size()) {
+		cout << "No camera " << index << ".." << endl;
+		return NULL;
+	}
+	return cameras[index]->ringFrameData8(numel);
+}
+
+void NITCamArray::releaseAlignedFrames() {
+	for (size_t i = 0; i < cameras.size(); ++i) {
+		cameras[i]->releaseRingFrame();
+	}
+}
+
+unsigned long long NITCamArray::unalignedFrames() {
+	return unalignedCount;
+}
+
+unsigned long long NITCamArray::reanchors() {
+	return reanchorCount;
+}
+
+unsigned long long NITCamArray::ringOverflows() {
+	unsigned long long overflows = 0;
+	for (size_t i = 0; i < cameras.size(); ++i) {
+		overflows += cameras[i]->ringOverflows();
+	}
+	return overflows;
+}
@@ -0,0 +1,106 @@
+#ifndef NITCAMARRAY_H
+#define NITCAMARRAY_H
+
+#include "NITCam.h"
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+/** \brief Several NIT cameras triggered together
+ *
+ * The cameras are opened by serial number and configured and armed concurrently, one thread per camera, so the
+ * setup time doesn't grow with the number of cameras. Armed cameras wait for the external trigger and stream into
+ * their own frame ring (see NITCam::startFrameRing). nextAlignedFrames pairs the ring fronts by frame Id: the Id of
+ * the first frame after arm is the origin of each camera, frames one camera got and another one missed are dropped.
+ * Ids are counted on across a roll over of the device counter (16-bit on GigE cameras).
+ * A camera that lost its first frames before arm returned has an origin one or more triggers late, the Ids can't
+ * tell. The pairs are therefore checked against the host times the frames entered their pipelines (see
+ * FrameStatistics): when they are more than 3/4 of the trigger period apart, the frames that entered early are
+ * dropped and the origins taken again. If the frames still disagree right after that, the cameras have a constant
+ * skew rather than an Id offset: it is reported and the check stays off until the next arm.
+ *
+ */
+class NITCamArray {
+	vector<NITCam*> cameras;
+	vector<string> serials;
+
+	// last Id of each camera and its index, the Id counted on across roll overs, valid once hasIndex is set
+	vector<unsigned long long> lastIds;
+	vector<unsigned long long> lastIndices;
+	vector<bool> hasIndex;
+	// index of the first frame of each camera since arm, valid once hasOrigin is set
+	vector<unsigned long long> originIds;
+	vector<bool> hasOrigin;
+	// Id of the aligned frames relative to the origins, valid after nextAlignedFrames returned true
+	unsigned long long alignedId;
+	// Id offset of the aligned frames of the last re-anchoring, set once frames were aligned
+	unsigned long long alignedBase;
+	bool alignedAny;
+	unsigned long long unalignedCount;
+	unsigned long long reanchorCount;
+	// trigger period in seconds: the nominal one of the device at arm, the shortest interval between two
+	// consecutive frames of the first camera once measured (a pause of the trigger doesn't stretch it)
+	double nominalPeriod;
+	double framePeriod;
+	chrono::steady_clock::time_point lastReceived;
+	// the arrival check is switched off by a constant skew, reanchored is set until the frames after a re-anchoring agreed
+	bool checkArrivals;
+	bool reanchored;
+
+	bool forEachCamera(const function<bool(NITCam&)>& task);
+	void resetAlignment();
+	unsigned long long frameIndex(size_t camera, const FrameRing::Slot& slot);
+	bool arrivalsAgree();
+
+	public:
+		NITCamArray();
+		~NITCamArray();
+
+		/** \brief Open the cameras of a comma separated list of serial numbers, all discovered cameras if empty
+		 *
+		 * The cameras already open are closed first. Returns the number of cameras opened, cameras that can't be
+		 * opened are reported and left out.
+		 *
+		 */
+		int open(const string serialNumbers);
+		void close();
+
+		unsigned int cameraCount();
+		string serialNumber(unsigned int index);
+		/** \brief Direct access to one camera, for the settings not covered by the array */
+		NITCam& camera(unsigned int index);
+
+		/** \brief Set mode, trigger delay and exposure time of every camera, true if all of them succeeded */
+		bool configure(bool gatedMode, double triggerDelayInput, double exposureTime);
+		/** \brief Switch every camera to trigger input and stream into rings of slotCount frames
+		 *
+		 * int bitMode: 0 = 14-bit, 1 = 8-bit manual gain control, 2 = 8-bit automatic gain control
+		 * Start the trigger after arm returned true.
+		 *
+		 */
+		bool arm(unsigned int slotCount, int bitMode);
+		/** \brief Stop streaming, the queued frames stay readable */
+		void disarm();
+
+		/** \brief Drop unmatched frames until every ring front holds the same frame, false if a ring runs empty
+		 *
+		 * Read the aligned frames with alignedFrameData16 / alignedFrameData8 and hand them back with releaseAlignedFrames.
+		 *
+		 */
+		bool nextAlignedFrames();
+		/** \brief Frame Id of the aligned frames, counted from 0 at arm and continued after a re-anchoring */
+		unsigned long long alignedFrameId();
+		const unsigned short* alignedFrameData16(unsigned int index, size_t numel);
+		const unsigned char* alignedFrameData8(unsigned int index, size_t numel);
+		void releaseAlignedFrames();
+		/** \brief Frames dropped by nextAlignedFrames since arm because a camera missed them */
+		unsigned long long unalignedFrames();
+		/** \brief How often since arm the Id alignment disagreed with the arrival times and was taken again */
+		unsigned long long reanchors();
+		/** \brief Frames dropped by the rings of all cameras since arm because they were full */
+		unsigned long long ringOverflows();
+};
+
+#endif
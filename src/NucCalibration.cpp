@@ -0,0 +1,102 @@
+#include "NucCalibration.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    float median(std::vector< float > values)
+    {
+        if( values.empty() )
+            return 0.0f;
+        std::vector< float >::iterator middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+}
+
+NucCalibration::NucCalibration() : maxResponseDeviation(0.5f), noiseFactor(5.0f)
+{
+}
+
+void NucCalibration::setPoint(double exposure_time, int mode, bool high, unsigned int rows, unsigned int columns,
+                              const std::vector< float >& mean, const std::vector< float >& stddev)
+{
+    Point& point = points[PointKey(mode, exposure_time)];
+    FlatField& field = high ? point.high : point.low;
+    field.rows = rows;
+    field.columns = columns;
+    field.mean = mean;
+    field.stddev = stddev;
+}
+
+void NucCalibration::completePoints(std::vector< double >& exposure_times, std::vector< int >& modes) const
+{
+    exposure_times.clear();
+    modes.clear();
+    for( std::map< PointKey, Point >::const_iterator it = points.begin(); it != points.end(); ++it )
+    {
+        if( !it->second.low.mean.empty() && !it->second.high.mean.empty() )
+        {
+            modes.push_back(it->first.first);
+            exposure_times.push_back(it->first.second);
+        }
+    }
+}
+
+bool NucCalibration::compute(double exposure_time, int mode, Result& result) const
+{
+    std::map< PointKey, Point >::const_iterator it = points.find(PointKey(mode, exposure_time));
+    if( it == points.end() )
+        return false;
+    const FlatField& low = it->second.low;
+    const FlatField& high = it->second.high;
+    if( low.mean.empty() || high.mean.empty() || low.rows != high.rows || low.columns != high.columns )
+        return false;
+
+    size_t count = low.mean.size();
+    std::vector< float > response(count), noise(count);
+    for( size_t i = 0; i < count; ++i )
+    {
+        response[i] = high.mean[i] - low.mean[i];
+        noise[i] = std::max(low.stddev[i], high.stddev[i]);
+    }
+    float median_response = median(response);
+    float noise_limit = noiseFactor * std::max(median(noise), 1.0f);
+    if( median_response <= 0.0f )
+        return false;       // the high flat field isn't brighter than the low one
+
+    result.rows = low.rows;
+    result.columns = low.columns;
+    result.badPixels.assign(count, 0);
+    result.badPixelCount = 0;
+    double low_sum = 0.0, high_sum = 0.0;
+    size_t good = 0;
+    for( size_t i = 0; i < count; ++i )
+    {
+        bool bad = std::fabs(response[i] - median_response) > maxResponseDeviation * median_response || noise[i] > noise_limit;
+        if( bad )
+        {
+            result.badPixels[i] = 1;
+            ++result.badPixelCount;
+            continue;
+        }
+        low_sum += low.mean[i];
+        high_sum += high.mean[i];
+        ++good;
+    }
+    if( good == 0 )
+        return false;
+
+    float frame_low = (float)(low_sum / good);
+    float frame_response = (float)(high_sum / good) - frame_low;
+    result.gain.resize(count);
+    result.offset.resize(count);
+    for( size_t i = 0; i < count; ++i )
+    {
+        float gain = result.badPixels[i] ? 1.0f : frame_response / response[i];
+        result.gain[i] = gain;
+        result.offset[i] = result.badPixels[i] ? 0.0f : frame_low - gain * low.mean[i];
+    }
+    return true;
+}
@@ -0,0 +1,293 @@
+#include "NucFile.h"
+#include "NucFilter.h"          // NucMode
+
+#include <Windows.h>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <map>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
+
+namespace
+{
+    struct Matrix
+    {
+        Matrix() : rows(0), columns(0) {}
+        int rows, columns;
+        std::vector< float > data;
+    };
+
+    std::string trim(const std::string& s)
+    {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        if( b == std::string::npos )
+            return std::string();
+        size_t e = s.find_last_not_of(" \t\r\n");
+        return s.substr(b, e - b + 1);
+    }
+
+    std::string lower(std::string s)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return s;
+    }
+
+    bool contains(const std::string& s, const char* word)
+    {
+        return s.find(word) != std::string::npos;
+    }
+
+    /** Minimal FileStorage YAML: "key: value" lines and "key: !!opencv-matrix" blocks **/
+    bool parseYaml(const std::string& text, std::map<std::string, std::string>& scalars, std::map<std::string, Matrix>& matrices)
+    {
+        size_t pos = 0;
+        Matrix* matrix = NULL;
+        while( pos < text.size() )
+        {
+            size_t end = text.find('\n', pos);
+            if( end == std::string::npos )
+                end = text.size();
+            std::string line = trim(text.substr(pos, end - pos));
+            size_t line_start = pos;
+            pos = end + 1;
+
+            if( line.empty() || line[0] == '%' || line[0] == '#' || line.compare(0, 3, "---") == 0 )
+                continue;
+            size_t colon = line.find(':');
+            if( colon == std::string::npos )
+                continue;
+            std::string key = trim(line.substr(0, colon));
+            std::string value = trim(line.substr(colon + 1));
+
+            if( matrix != NULL )
+            {
+                if( key == "rows" )
+                {
+                    matrix->rows = std::atoi(value.c_str());
+                    continue;
+                }
+                if( key == "cols" )
+                {
+                    matrix->columns = std::atoi(value.c_str());
+                    continue;
+                }
+                if( key == "dt" )
+                    continue;
+                if( key == "data" )
+                {
+                    // the list runs over many lines, parse it straight from the text
+                    size_t bracket = text.find('[', line_start);
+                    if( bracket == std::string::npos )
+                        return false;
+                    matrix->data.reserve((size_t)std::max(matrix->rows, 0) * std::max(matrix->columns, 0));
+                    const char* p = text.c_str() + bracket + 1;
+                    for(;;)
+                    {
+                        while( *p == ' ' || *p == ',' || *p == '\n' || *p == '\r' || *p == '\t' )
+                            ++p;
+                        if( *p == ']' || *p == '\0' )
+                            break;
+                        char* number_end;
+                        float v = std::strtof(p, &number_end);
+                        if( number_end == p )
+                            return false;
+                        matrix->data.push_back(v);
+                        p = number_end;
+                    }
+                    if( *p != ']' )
+                        return false;
+                    pos = (size_t)(p - text.c_str()) + 1;
+                    matrix = NULL;
+                    continue;
+                }
+                matrix = NULL;      // a matrix without data, go on with the key
+            }
+
+            if( value.compare(0, 15, "!!opencv-matrix") == 0 )
+                matrix = &matrices[lower(key)];
+            else if( !value.empty() )
+                scalars[lower(key)] = value;
+        }
+        return true;
+    }
+
+    /** "0.2us", "200ns", "1ms" in the file name, in us **/
+    double exposureFromName(const std::string& name)
+    {
+        std::string n = lower(name);
+        static const char* units[3] = { "us", "ns", "ms" };
+        static const double factors[3] = { 1.0, 1e-3, 1e3 };
+        for( int u = 0; u < 3; ++u )
+        {
+            for( size_t at = n.find(units[u]); at != std::string::npos; at = n.find(units[u], at + 1) )
+            {
+                size_t begin = at;
+                while( begin > 0 && (std::isdigit((unsigned char)n[begin - 1]) || n[begin - 1] == '.') )
+                    --begin;
+                if( begin < at && std::isdigit((unsigned char)n[at - 1]) )
+                    return std::atof(n.substr(begin, at - begin).c_str()) * factors[u];
+            }
+        }
+        return -1.0;
+    }
+
+    int modeFromText(const std::string& text)
+    {
+        std::string t = lower(text);
+        if( contains(t, "gated") )
+            return NUC_GATED;
+        if( contains(t, "global") || contains(t, "shutter") || contains(t, "_gs") )
+            return NUC_GLOBAL_SHUTTER;
+        return NUC_ANY_MODE;
+    }
+
+    const char* modeName(int mode)
+    {
+        return mode == NUC_GATED ? "Gated" : mode == NUC_GLOBAL_SHUTTER ? "GlobalShutter" : "Any";
+    }
+
+    template< typename T >
+    void writeMatrix(std::string& out, const char* name, const char* type, unsigned int rows, unsigned int columns, const T* data, const char* format)
+    {
+        char line[64];
+        std::snprintf(line, sizeof(line), "%s: !!opencv-matrix\n", name);
+        out += line;
+        std::snprintf(line, sizeof(line), "   rows: %u\n   cols: %u\n   dt: %s\n   data: [ ", rows, columns, type);
+        out += line;
+        size_t count = (size_t)rows * columns;
+        for( size_t i = 0; i < count; ++i )
+        {
+            std::snprintf(line, sizeof(line), format, data[i]);
+            out += line;
+            if( i + 1 < count )
+                out += (i % 8 == 7) ? ",\n       " : ", ";
+        }
+        out += " ]\n";
+    }
+}
+
+std::vector< std::string > listNucFiles(const std::string& directory)
+{
+    std::vector< std::string > files;
+    std::string dir = directory;
+    std::string nuc_dir = directory + "/NUC";
+    DWORD attributes = GetFileAttributesA(nuc_dir.c_str());
+    if( attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) )
+        dir = nuc_dir;
+
+    WIN32_FIND_DATAA found;
+    HANDLE search = FindFirstFileA((dir + "/*.yml").c_str(), &found);
+    if( search == INVALID_HANDLE_VALUE )
+        return files;
+    do
+    {
+        if( !(found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) )
+            files.push_back(dir + "/" + found.cFileName);
+    }
+    while( FindNextFileA(search, &found) );
+    FindClose(search);
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::shared_ptr<NucTable> readNucFile(const std::string& path, NucFileInfo& info)
+{
+    info = NucFileInfo();
+    info.path = path;
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    std::ifstream in(path.c_str(), std::ios::binary);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::map<std::string, std::string> scalars;
+    std::map<std::string, Matrix> matrices;
+    bool parsed = in.is_open() && parseYaml(buffer.str(), scalars, matrices);
+
+    for( std::map<std::string, std::string>::const_iterator it = scalars.begin(); it != scalars.end(); ++it )
+    {
+        if( info.exposureTime < 0.0 && (contains(it->first, "expo") || contains(it->first, "integration")) )
+            info.exposureTime = std::atof(it->second.c_str());
+        if( info.mode == NUC_ANY_MODE && contains(it->first, "mode") )
+            info.mode = modeFromText(it->second);
+    }
+    if( info.exposureTime < 0.0 )
+        info.exposureTime = exposureFromName(name);
+    if( info.mode == NUC_ANY_MODE )
+        info.mode = modeFromText(name);
+
+    if( !parsed )
+        return std::shared_ptr<NucTable>();
+
+    const Matrix* gain = NULL;
+    const Matrix* offset = NULL;
+    const Matrix* bad = NULL;
+    for( std::map<std::string, Matrix>::const_iterator it = matrices.begin(); it != matrices.end(); ++it )
+    {
+        const Matrix& m = it->second;
+        if( m.rows <= 0 || m.columns <= 0 || m.data.size() != (size_t)m.rows * m.columns )
+            continue;
+        if( contains(it->first, "gain") )
+            gain = &m;
+        else if( contains(it->first, "offset") )
+            offset = &m;
+        else if( contains(it->first, "bad") || contains(it->first, "bpr") )
+            bad = &m;
+    }
+    const Matrix* shape = gain != NULL ? gain : offset;
+    if( shape == NULL || (gain != NULL && offset != NULL && (gain->rows != offset->rows || gain->columns != offset->columns)) )
+        return std::shared_ptr<NucTable>();
+
+    size_t count = (size_t)shape->rows * shape->columns;
+    std::vector< float > ones, zeros;
+    if( gain == NULL )
+        ones.assign(count, 1.0f);
+    if( offset == NULL )
+        zeros.assign(count, 0.0f);
+    std::vector< unsigned char > bad_pixels;
+    if( bad != NULL && bad->rows == shape->rows && bad->columns == shape->columns )
+    {
+        bad_pixels.resize(count);
+        for( size_t i = 0; i < count; ++i )
+            bad_pixels[i] = bad->data[i] != 0.0f;
+    }
+
+    return std::make_shared<NucTable>(shape->rows, shape->columns,
+                                      gain != NULL ? gain->data.data() : ones.data(),
+                                      offset != NULL ? offset->data.data() : zeros.data(),
+                                      bad_pixels.empty() ? NULL : bad_pixels.data());
+}
+
+std::string nucFileName(double exposure_time, int mode)
+{
+    std::ostringstream name;
+    name << "NUCFactory_" << modeName(mode) << "_" << exposure_time << "us.yml";
+    return name.str();
+}
+
+bool writeNucFile(const NucFileInfo& info, unsigned int rows, unsigned int columns,
+                  const float* gain, const float* offset, const unsigned char* bad_pixels)
+{
+    std::ostringstream header;
+    header << "%YAML:1.0\n---\nExposureTime: " << info.exposureTime << "\nMode: " << modeName(info.mode) << "\n";
+    std::string text = header.str();
+    // about 16 characters per value
+    text.reserve(text.size() + (size_t)rows * columns * (bad_pixels != NULL ? 36 : 32));
+    writeMatrix(text, "Gain", "f", rows, columns, gain, "%.9g");
+    writeMatrix(text, "Offset", "f", rows, columns, offset, "%.9g");
+    if( bad_pixels != NULL )
+        writeMatrix(text, "BadPixels", "u", rows, columns, bad_pixels, "%u");
+
+    std::ofstream out(info.path.c_str(), std::ios::binary);
+    out.write(text.data(), (std::streamsize)text.size());
+    if( !out )
+    {
+        std::cout << "NUC: can't write " << info.path << std::endl;
+        return false;
+    }
+    return true;
+}
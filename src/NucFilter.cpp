@@ -0,0 +1,92 @@
+#include "NucFilter.h"
+
+#include <cmath>
+#include <algorithm>
+
+NucFilter::NucFilter() : correctedCount(0), mismatchCount(0)
+{
+}
+
+NucFilter::~NucFilter()
+{
+}
+
+NucFilter::TableMap::const_iterator NucFilter::find(double exposure_time, int mode) const
+{
+    // exposure times come back from the camera as doubles, compare with a small tolerance
+    double tolerance = 1e-6 * std::max(1.0, std::fabs(exposure_time));
+    TableMap::const_iterator it = tables.lower_bound(TableKey(mode, exposure_time - tolerance));
+    if( it != tables.end() && it->first.first == mode && it->first.second <= exposure_time + tolerance )
+        return it;
+    return tables.end();
+}
+
+NucFilter::TableMap::const_iterator NucFilter::findForMode(double exposure_time, int mode) const
+{
+    TableMap::const_iterator it = find(exposure_time, mode);
+    if( it == tables.end() && mode != NUC_ANY_MODE )
+        it = find(exposure_time, NUC_ANY_MODE);
+    return it;
+}
+
+void NucFilter::addTable(double exposure_time, const std::shared_ptr<const NucTable>& table, int mode)
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    TableMap::const_iterator it = find(exposure_time, mode);
+    if( it != tables.end() )
+    {
+        // the selected table is replaced too
+        if( std::atomic_load(&current) == it->second )
+            std::atomic_store(&current, table);
+        tables.erase(it);
+    }
+    tables[TableKey(mode, exposure_time)] = table;
+}
+
+bool NucFilter::hasTable(double exposure_time, int mode) const
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    return findForMode(exposure_time, mode) != tables.end();
+}
+
+size_t NucFilter::tableCount() const
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    return tables.size();
+}
+
+void NucFilter::clearTables()
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    std::atomic_store(&current, std::shared_ptr<const NucTable>());
+    tables.clear();
+}
+
+bool NucFilter::selectExposure(double exposure_time, int mode)
+{
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    TableMap::const_iterator it = findForMode(exposure_time, mode);
+    std::atomic_store(&current, it != tables.end() ? it->second : std::shared_ptr<const NucTable>());
+    return it != tables.end();
+}
+
+std::shared_ptr<const NucTable> NucFilter::currentTable() const
+{
+    return std::atomic_load(&current);
+}
+
+void NucFilter::onNewFrame(NITLibrary::NITFrame& frame)
+{
+    std::shared_ptr<const NucTable> table = std::atomic_load(&current);
+    if( !table || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+        return;
+
+    if( frame.rows() != table->rows() || frame.columns() != table->columns() )
+    {
+        mismatchCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    table->apply(frame.data());
+    correctedCount.fetch_add(1, std::memory_order_relaxed);
+}
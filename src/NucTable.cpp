@@ -0,0 +1,78 @@
+#include "NucTable.h"
+#include "GainKernels.h"
+
+namespace
+{
+    // search radius for bad pixels without a good direct neighbour (clusters)
+    const int MAX_NEIGHBOUR_RADIUS = 3;
+}
+
+NucTable::NucTable(unsigned int rows, unsigned int columns, const float* gain, const float* offset, const unsigned char* bad_pixels)
+    : tableRows(rows), tableColumns(columns),
+      gainTable(gain, gain + (size_t)rows * columns), offsetTable(offset, offset + (size_t)rows * columns)
+{
+    if( bad_pixels != NULL )
+        findNeighbours(bad_pixels);
+}
+
+void NucTable::findNeighbours(const unsigned char* bad_pixels)
+{
+    const int rows = (int)tableRows, columns = (int)tableColumns;
+    for( int r = 0; r < rows; ++r )
+    {
+        for( int c = 0; c < columns; ++c )
+        {
+            unsigned int index = (unsigned int)(r * columns + c);
+            if( !bad_pixels[index] )
+                continue;
+
+            Replacement replacement;
+            replacement.index = index;
+            replacement.first = (unsigned int)neighbourList.size();
+
+            // 4-connected first, then the 8-connected ring, then wider rings for clusters
+            static const int cross[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+            for( int k = 0; k < 4; ++k )
+            {
+                int nr = r + cross[k][0], nc = c + cross[k][1];
+                if( nr >= 0 && nr < rows && nc >= 0 && nc < columns && !bad_pixels[nr * columns + nc] )
+                    neighbourList.push_back((unsigned int)(nr * columns + nc));
+            }
+            for( int radius = 1; radius <= MAX_NEIGHBOUR_RADIUS && neighbourList.size() == replacement.first; ++radius )
+            {
+                for( int dr = -radius; dr <= radius; ++dr )
+                {
+                    for( int dc = -radius; dc <= radius; ++dc )
+                    {
+                        if( (dr != -radius && dr != radius && dc != -radius && dc != radius) || (radius == 1 && (dr == 0 || dc == 0)) )
+                            continue;       // inside the ring, or already tried above
+                        int nr = r + dr, nc = c + dc;
+                        if( nr >= 0 && nr < rows && nc >= 0 && nc < columns && !bad_pixels[nr * columns + nc] )
+                            neighbourList.push_back((unsigned int)(nr * columns + nc));
+                    }
+                }
+            }
+
+            replacement.count = (unsigned int)neighbourList.size() - replacement.first;
+            replacements.push_back(replacement);
+        }
+    }
+}
+
+void NucTable::apply(float* pixels) const
+{
+    applyGainOffset(pixels, gainTable.data(), offsetTable.data(), gainTable.size());
+
+    // neighbours are good pixels, so the order of the replacements doesn't matter
+    const unsigned int* neighbours = neighbourList.data();
+    for( size_t i = 0; i < replacements.size(); ++i )
+    {
+        const Replacement& replacement = replacements[i];
+        if( replacement.count == 0 )
+            continue;
+        float sum = 0.0f;
+        for( unsigned int k = 0; k < replacement.count; ++k )
+            sum += pixels[neighbours[replacement.first + k]];
+        pixels[replacement.index] = sum / (float)replacement.count;
+    }
+}
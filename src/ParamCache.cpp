@@ -0,0 +1,143 @@
+#include "ParamCache.h"
+
+#include <cctype>
+#include <cmath>
+
+ParamCache::ParamCache()
+{
+}
+
+ParamCache::~ParamCache()
+{
+}
+
+std::string ParamCache::key(const std::string& param_name)
+{
+    std::string k;
+    k.reserve(param_name.size());
+    for( size_t i = 0; i < param_name.size(); ++i )
+    {
+        unsigned char c = (unsigned char)param_name[i];
+        if( c != ' ' && c != '_' )
+            k += (char)std::tolower(c);
+    }
+    return k;
+}
+
+bool ParamCache::sameString(const std::string& a, const std::string& b)
+{
+    if( a.size() != b.size() )
+        return false;
+    for( size_t i = 0; i < a.size(); ++i )
+        if( std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i]) )
+            return false;
+    return true;
+}
+
+bool ParamCache::sameNumber(double a, double b)
+{
+    // the observer reports floats, so only compare to float precision
+    double scale = std::fabs(a) > 1.0 ? std::fabs(a) : 1.0;
+    return std::fabs(a - b) <= 1e-5 * scale;
+}
+
+bool ParamCache::holds(const Entry& entry, const Value& value)
+{
+    if( !value.valid )
+        return false;
+    return value.numeric ? sameNumber(entry.numValue, value.num) : sameString(entry.strValue, value.str);
+}
+
+void ParamCache::update(const char* param_name, const char* str_value, float num_value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    Entry& entry = entries[key(param_name)];
+    entry.strValue = str_value ? str_value : "";
+    entry.numValue = num_value;
+
+    if( entry.pending.valid && !holds(entry, entry.pending) )
+        entry.alias = entry.pending;    // our request was adapted by the device
+    else
+        entry.alias = Value();          // exact value or changed by someone else
+    entry.pending = Value();
+}
+
+bool ParamCache::matches(const std::string& param_name, const std::string& value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::map< std::string, Entry >::const_iterator it = entries.find(key(param_name));
+    if( it == entries.end() )
+        return false;
+    const Entry& entry = it->second;
+    if( sameString(entry.strValue, value) )
+        return true;
+    return entry.alias.valid && !entry.alias.numeric && sameString(entry.alias.str, value);
+}
+
+bool ParamCache::matches(const std::string& param_name, double value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::map< std::string, Entry >::const_iterator it = entries.find(key(param_name));
+    if( it == entries.end() )
+        return false;
+    const Entry& entry = it->second;
+    if( sameNumber(entry.numValue, value) )
+        return true;
+    return entry.alias.valid && entry.alias.numeric && sameNumber(entry.alias.num, value);
+}
+
+void ParamCache::request(const std::string& param_name, const std::string& value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    Value& pending = entries[key(param_name)].pending;
+    pending.valid = true;
+    pending.numeric = false;
+    pending.str = value;
+}
+
+void ParamCache::request(const std::string& param_name, double value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    Value& pending = entries[key(param_name)].pending;
+    pending.valid = true;
+    pending.numeric = true;
+    pending.num = value;
+}
+
+void ParamCache::settle()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for( std::map< std::string, Entry >::iterator it = entries.begin(); it != entries.end(); ++it )
+    {
+        Entry& entry = it->second;
+        if( entry.pending.valid )
+        {
+            // no change was reported, so the device kept its value for this request
+            entry.alias = holds(entry, entry.pending) ? Value() : entry.pending;
+            entry.pending = Value();
+        }
+    }
+}
+
+void ParamCache::invalidatePending()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for( std::map< std::string, Entry >::iterator it = entries.begin(); it != entries.end(); )
+    {
+        if( it->second.pending.valid )
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool ParamCache::lookup(const std::string& param_name, std::string& str_value, float& num_value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::map< std::string, Entry >::const_iterator it = entries.find(key(param_name));
+    if( it == entries.end() )
+        return false;
+    str_value = it->second.strValue;
+    num_value = it->second.numValue;
+    return true;
+}
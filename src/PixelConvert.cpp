@@ -0,0 +1,317 @@
+#include "PixelConvert.h"
+#include "SimdTranspose.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    template< typename T >
+    inline T saturate(float v, float max_value)
+    {
+        v = v < 0.0f ? 0.0f : v > max_value ? max_value : v;
+        // same round half to even as the SIMD conversion
+        return (T)std::lrint(v);
+    }
+
+    void packUint16Scalar(const float* src, unsigned short* dst, size_t count, float scale)
+    {
+        for( size_t i = 0; i < count; ++i )
+            dst[i] = saturate<unsigned short>(src[i] * scale, 65535.0f);
+    }
+
+    void packUint8Scalar(const float* src, unsigned char* dst, size_t count, float scale)
+    {
+        for( size_t i = 0; i < count; ++i )
+            dst[i] = saturate<unsigned char>(src[i] * scale, 255.0f);
+    }
+
+    SIMD_TARGET_SSE41 void packUint16Sse41(const float* src, unsigned short* dst, size_t count, float scale)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        const __m128 lo = _mm_setzero_ps();
+        const __m128 hi = _mm_set1_ps(65535.0f);
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8 )
+        {
+            __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), s), lo), hi);
+            __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), s), lo), hi);
+            __m128i packed = _mm_packus_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128((__m128i*)(dst + i), packed);
+        }
+        packUint16Scalar(src + i, dst + i, count - i, scale);
+    }
+
+    SIMD_TARGET_SSE41 void packUint8Sse41(const float* src, unsigned char* dst, size_t count, float scale)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        const __m128 lo = _mm_setzero_ps();
+        const __m128 hi = _mm_set1_ps(255.0f);
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m128i v[4];
+            for( int k = 0; k < 4; ++k )
+                v[k] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4 * k), s), lo), hi));
+            __m128i packed = _mm_packus_epi16(_mm_packus_epi32(v[0], v[1]), _mm_packus_epi32(v[2], v[3]));
+            _mm_storeu_si128((__m128i*)(dst + i), packed);
+        }
+        packUint8Scalar(src + i, dst + i, count - i, scale);
+    }
+
+    SIMD_TARGET_AVX2 void packUint16Avx2(const float* src, unsigned short* dst, size_t count, float scale)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        const __m256 lo = _mm256_setzero_ps();
+        const __m256 hi = _mm256_set1_ps(65535.0f);
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), s), lo), hi);
+            __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), s), lo), hi);
+            // packus works per 128 bit lane, put the quadwords back in order
+            __m256i packed = _mm256_packus_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+            packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(dst + i), packed);
+        }
+        packUint16Scalar(src + i, dst + i, count - i, scale);
+    }
+
+    SIMD_TARGET_AVX2 void packUint8Avx2(const float* src, unsigned char* dst, size_t count, float scale)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        const __m256 lo = _mm256_setzero_ps();
+        const __m256 hi = _mm256_set1_ps(255.0f);
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        size_t i = 0;
+        for( ; i + 32 <= count; i += 32 )
+        {
+            __m256i v[4];
+            for( int k = 0; k < 4; ++k )
+                v[k] = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8 * k), s), lo), hi));
+            __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(v[0], v[1]), _mm256_packus_epi32(v[2], v[3]));
+            packed = _mm256_permutevar8x32_epi32(packed, order);
+            _mm256_storeu_si256((__m256i*)(dst + i), packed);
+        }
+        packUint8Scalar(src + i, dst + i, count - i, scale);
+    }
+
+    /** Column major packing: the frame is walked in TILE x TILE tiles so the rows read and the **/
+    /** columns written stay in L1, each 8 x 8 (4 x 4) block is transposed in registers and     **/
+    /** converted on the way out. dst[c * rows + r] = convert(src[r * columns + c] * scale)       **/
+    const size_t TILE = 32;
+
+    inline void convertPixel(float v, unsigned short& dst) { dst = saturate<unsigned short>(v, 65535.0f); }
+    inline void convertPixel(float v, unsigned char& dst)  { dst = saturate<unsigned char>(v, 255.0f); }
+    inline void convertPixel(float v, float& dst)          { dst = v; }
+
+    template< typename T >
+    void packColumnMajorTileScalar(const float* src, T* dst, size_t rows, size_t columns,
+                                   size_t r0, size_t r1, size_t c0, size_t c1, float scale)
+    {
+        // column by column, so the destination is written sequentially
+        for( size_t c = c0; c < c1; ++c )
+        {
+            T* d = dst + c * rows;
+            for( size_t r = r0; r < r1; ++r )
+                convertPixel(src[r * columns + c] * scale, d[r]);
+        }
+    }
+
+    SIMD_TARGET_SSE41 inline void storeColumnsSse41(float* dst, size_t rows, const __m128 v[4])
+    {
+        for( int k = 0; k < 4; ++k )
+            _mm_storeu_ps(dst + k * rows, v[k]);
+    }
+
+    SIMD_TARGET_SSE41 inline void storeColumnsSse41(unsigned short* dst, size_t rows, const __m128 v[4])
+    {
+        const __m128 lo = _mm_setzero_ps();
+        const __m128 hi = _mm_set1_ps(65535.0f);
+        for( int k = 0; k < 4; ++k )
+        {
+            __m128i i = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v[k], lo), hi));
+            _mm_storel_epi64((__m128i*)(dst + k * rows), _mm_packus_epi32(i, i));
+        }
+    }
+
+    SIMD_TARGET_SSE41 inline void storeColumnsSse41(unsigned char* dst, size_t rows, const __m128 v[4])
+    {
+        const __m128 lo = _mm_setzero_ps();
+        const __m128 hi = _mm_set1_ps(255.0f);
+        for( int k = 0; k < 4; ++k )
+        {
+            __m128i i = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v[k], lo), hi));
+            i = _mm_packus_epi32(i, i);
+            int packed = _mm_cvtsi128_si32(_mm_packus_epi16(i, i));
+            std::memcpy(dst + k * rows, &packed, 4);
+        }
+    }
+
+    template< typename T >
+    SIMD_TARGET_SSE41 void packColumnMajorTileSse41(const float* src, T* dst, size_t rows, size_t columns,
+                                                    size_t r0, size_t r1, size_t c0, size_t c1, float scale)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        size_t r = r0;
+        for( ; r + 4 <= r1; r += 4 )
+        {
+            size_t c = c0;
+            for( ; c + 4 <= c1; c += 4 )
+            {
+                __m128 v[4];
+                simdTranspose4x4(src + r * columns + c, columns, v);
+                for( int k = 0; k < 4; ++k )
+                    v[k] = _mm_mul_ps(v[k], s);
+                storeColumnsSse41(dst + c * rows + r, rows, v);
+            }
+            packColumnMajorTileScalar(src, dst, rows, columns, r, r + 4, c, c1, scale);
+        }
+        packColumnMajorTileScalar(src, dst, rows, columns, r, r1, c0, c1, scale);
+    }
+
+    SIMD_TARGET_AVX2 inline void storeColumnsAvx2(float* dst, size_t rows, const __m256 v[8])
+    {
+        for( int k = 0; k < 8; ++k )
+            _mm256_storeu_ps(dst + k * rows, v[k]);
+    }
+
+    SIMD_TARGET_AVX2 inline __m256i packColumnPairAvx2(__m256 a, __m256 b, __m256 hi)
+    {
+        const __m256 lo = _mm256_setzero_ps();
+        a = _mm256_min_ps(_mm256_max_ps(a, lo), hi);
+        b = _mm256_min_ps(_mm256_max_ps(b, lo), hi);
+        // packus works per 128 bit lane: column a in the low half, column b in the high half
+        __m256i packed = _mm256_packus_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+
+    SIMD_TARGET_AVX2 inline void storeColumnsAvx2(unsigned short* dst, size_t rows, const __m256 v[8])
+    {
+        const __m256 hi = _mm256_set1_ps(65535.0f);
+        for( int k = 0; k < 8; k += 2 )
+        {
+            __m256i packed = packColumnPairAvx2(v[k], v[k + 1], hi);
+            _mm_storeu_si128((__m128i*)(dst + k * rows), _mm256_castsi256_si128(packed));
+            _mm_storeu_si128((__m128i*)(dst + (k + 1) * rows), _mm256_extracti128_si256(packed, 1));
+        }
+    }
+
+    SIMD_TARGET_AVX2 inline void storeColumnsAvx2(unsigned char* dst, size_t rows, const __m256 v[8])
+    {
+        const __m256 hi = _mm256_set1_ps(255.0f);
+        for( int k = 0; k < 8; k += 2 )
+        {
+            __m256i packed = packColumnPairAvx2(v[k], v[k + 1], hi);
+            packed = _mm256_packus_epi16(packed, packed);
+            _mm_storel_epi64((__m128i*)(dst + k * rows), _mm256_castsi256_si128(packed));
+            _mm_storel_epi64((__m128i*)(dst + (k + 1) * rows), _mm256_extracti128_si256(packed, 1));
+        }
+    }
+
+    template< typename T >
+    SIMD_TARGET_AVX2 void packColumnMajorTileAvx2(const float* src, T* dst, size_t rows, size_t columns,
+                                                  size_t r0, size_t r1, size_t c0, size_t c1, float scale)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        size_t r = r0;
+        for( ; r + 8 <= r1; r += 8 )
+        {
+            size_t c = c0;
+            for( ; c + 8 <= c1; c += 8 )
+            {
+                __m256 v[8];
+                simdTranspose8x8(src + r * columns + c, columns, v);
+                for( int k = 0; k < 8; ++k )
+                    v[k] = _mm256_mul_ps(v[k], s);
+                storeColumnsAvx2(dst + c * rows + r, rows, v);
+            }
+            packColumnMajorTileScalar(src, dst, rows, columns, r, r + 8, c, c1, scale);
+        }
+        packColumnMajorTileScalar(src, dst, rows, columns, r, r1, c0, c1, scale);
+    }
+
+    template< typename T >
+    struct ColumnMajorTile
+    {
+        typedef void (*Func)(const float*, T*, size_t, size_t, size_t, size_t, size_t, size_t, float);
+    };
+
+    template< typename T >
+    typename ColumnMajorTile<T>::Func selectColumnMajorTile()
+    {
+        if( simdHasAvx2() )
+            return packColumnMajorTileAvx2<T>;
+        if( simdHasSse41() )
+            return packColumnMajorTileSse41<T>;
+        return packColumnMajorTileScalar<T>;
+    }
+
+    template< typename T >
+    void packColumnMajor(typename ColumnMajorTile<T>::Func tile, const float* src, T* dst, size_t rows, size_t columns, float scale)
+    {
+        for( size_t r0 = 0; r0 < rows; r0 += TILE )
+            for( size_t c0 = 0; c0 < columns; c0 += TILE )
+                tile(src, dst, rows, columns, r0, std::min(r0 + TILE, rows), c0, std::min(c0 + TILE, columns), scale);
+    }
+
+    typedef void (*PackUint16Func)(const float*, unsigned short*, size_t, float);
+    typedef void (*PackUint8Func)(const float*, unsigned char*, size_t, float);
+
+    PackUint16Func selectPackUint16()
+    {
+        if( simdHasAvx2() )
+            return packUint16Avx2;
+        if( simdHasSse41() )
+            return packUint16Sse41;
+        return packUint16Scalar;
+    }
+
+    PackUint8Func selectPackUint8()
+    {
+        if( simdHasAvx2() )
+            return packUint8Avx2;
+        if( simdHasSse41() )
+            return packUint8Sse41;
+        return packUint8Scalar;
+    }
+
+    const PackUint16Func packUint16Impl = selectPackUint16();
+    const PackUint8Func packUint8Impl = selectPackUint8();
+    const ColumnMajorTile<unsigned short>::Func packUint16ColumnMajorTile = selectColumnMajorTile<unsigned short>();
+    const ColumnMajorTile<unsigned char>::Func packUint8ColumnMajorTile = selectColumnMajorTile<unsigned char>();
+    const ColumnMajorTile<float>::Func packFloatColumnMajorTile = selectColumnMajorTile<float>();
+}
+
+void packUint16(const float* src, unsigned short* dst, size_t count, float scale)
+{
+    packUint16Impl(src, dst, count, scale);
+}
+
+void packUint8(const float* src, unsigned char* dst, size_t count, float scale)
+{
+    packUint8Impl(src, dst, count, scale);
+}
+
+void packFloat(const float* src, float* dst, size_t count, float scale)
+{
+    // a plain loop, the compilers vectorize it
+    for( size_t i = 0; i < count; ++i )
+        dst[i] = src[i] * scale;
+}
+
+void packUint16ColumnMajor(const float* src, unsigned short* dst, unsigned int rows, unsigned int columns, float scale)
+{
+    packColumnMajor(packUint16ColumnMajorTile, src, dst, rows, columns, scale);
+}
+
+void packUint8ColumnMajor(const float* src, unsigned char* dst, unsigned int rows, unsigned int columns, float scale)
+{
+    packColumnMajor(packUint8ColumnMajorTile, src, dst, rows, columns, scale);
+}
+
+void packFloatColumnMajor(const float* src, float* dst, unsigned int rows, unsigned int columns, float scale)
+{
+    packColumnMajor(packFloatColumnMajorTile, src, dst, rows, columns, scale);
+}
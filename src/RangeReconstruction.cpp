@@ -0,0 +1,147 @@
+#include "RangeReconstruction.h"
+
+#include <iostream>
+#include <limits>
+
+// light travels 299.792458 m per microsecond, the gate sees the round trip
+static const float METRES_PER_MICROSECOND = 299.792458f / 2.0f;
+
+RangeReconstruction::RangeReconstruction() : minIntensity(0.0f), centroidHalfWidth(2), mapRows(0), mapColumns(0)
+{
+}
+
+RangeReconstruction::~RangeReconstruction()
+{
+}
+
+bool RangeReconstruction::compute(const unsigned short* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                                  const double* delays, eMethod method)
+{
+    return computeStack(stack, steps, rows, columns, delays, method);
+}
+
+bool RangeReconstruction::compute(const unsigned char* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                                  const double* delays, eMethod method)
+{
+    return computeStack(stack, steps, rows, columns, delays, method);
+}
+
+bool RangeReconstruction::compute(const float* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                                  const double* delays, eMethod method)
+{
+    return computeStack(stack, steps, rows, columns, delays, method);
+}
+
+template< typename T >
+bool RangeReconstruction::computeStack(const T* stack, unsigned int steps, unsigned int rows, unsigned int columns,
+                                       const double* delays, eMethod method)
+{
+    if( stack == NULL || steps == 0 || steps > std::numeric_limits<unsigned short>::max() || rows == 0 || columns == 0 )
+    {
+        std::cout << "RangeReconstruction: invalid stack " << steps << " x " << rows << " x " << columns << std::endl;
+        return false;
+    }
+
+    size_t frame_size = (size_t)rows * columns;
+    mapRows = rows;
+    mapColumns = columns;
+    rangeMap.resize(frame_size);
+    delayMap.resize(frame_size);
+    intensityMap.resize(frame_size);
+    peakMap.resize(frame_size);
+    stepDelays.assign(delays, delays + steps);
+
+    // bands of whole rows keep each thread on its own cache lines
+    pool.parallelFor(rows, [&](size_t first_row, size_t last_row)
+    {
+        computeBand(stack, steps, frame_size, method, first_row * columns, last_row * columns);
+    });
+    return true;
+}
+
+template< typename T >
+void RangeReconstruction::computeBand(const T* stack, unsigned int steps, size_t frame_size, eMethod method, size_t begin, size_t end)
+{
+    float* best = intensityMap.data();
+    unsigned short* peak = peakMap.data();
+
+    // running maximum slice by slice, every slice is read contiguously and the loop has no branches
+    for( size_t p = begin; p < end; ++p )
+    {
+        best[p] = (float)stack[p];
+        peak[p] = 0;
+    }
+    for( unsigned int s = 1; s < steps; ++s )
+    {
+        const T* slice = stack + s * frame_size;
+        unsigned short step = (unsigned short)s;
+        for( size_t p = begin; p < end; ++p )
+        {
+            float v = (float)slice[p];
+            bool brighter = v > best[p];
+            best[p] = brighter ? v : best[p];
+            peak[p] = brighter ? step : peak[p];
+        }
+    }
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for( size_t p = begin; p < end; ++p )
+    {
+        unsigned short k = peak[p];
+        float y1 = best[p];
+        if( y1 < minIntensity )
+        {
+            delayMap[p] = nan;
+            rangeMap[p] = nan;
+            continue;
+        }
+
+        float d = stepDelays[k];
+        if( method == PARABOLIC && k > 0 && k + 1u < steps )
+        {
+            float y0 = (float)stack[(k - 1) * frame_size + p];
+            float y2 = (float)stack[(k + 1) * frame_size + p];
+            float denom = y0 - 2.0f * y1 + y2;
+            if( denom < 0.0f )
+            {
+                float offset = 0.5f * (y0 - y2) / denom;
+                d = delayAt(k, offset);
+                best[p] = y1 - 0.25f * (y0 - y2) * offset;
+            }
+        }
+        else if( method == CENTROID )
+        {
+            unsigned int lo = k > centroidHalfWidth ? k - centroidHalfWidth : 0;
+            unsigned int hi = k + centroidHalfWidth < steps ? k + centroidHalfWidth : steps - 1;
+            // subtract the window floor so the background doesn't pull the centroid to the window centre
+            float floor_value = y1;
+            for( unsigned int j = lo; j <= hi; ++j )
+            {
+                float v = (float)stack[j * frame_size + p];
+                floor_value = v < floor_value ? v : floor_value;
+            }
+            float sum_w = 0.0f, sum_wd = 0.0f;
+            for( unsigned int j = lo; j <= hi; ++j )
+            {
+                float w = (float)stack[j * frame_size + p] - floor_value;
+                sum_w += w;
+                sum_wd += w * stepDelays[j];
+            }
+            if( sum_w > 0.0f )
+                d = sum_wd / sum_w;
+        }
+
+        delayMap[p] = d;
+        rangeMap[p] = d * METRES_PER_MICROSECOND;
+    }
+}
+
+float RangeReconstruction::delayAt(unsigned short index, float offset) const
+{
+    // offset is in steps, steps don't need to be equidistant
+    if( offset >= 0.0f && index + 1u < stepDelays.size() )
+        return stepDelays[index] + offset * (stepDelays[index + 1] - stepDelays[index]);
+    if( offset < 0.0f && index > 0 )
+        return stepDelays[index] + offset * (stepDelays[index] - stepDelays[index - 1]);
+    return stepDelays[index];
+}
@@ -0,0 +1,222 @@
+#include "SequenceReader.h"
+
+#include <cstring>
+#include <climits>
+#include <iostream>
+
+SequenceReader::SequenceReader() : file(INVALID_HANDLE_VALUE), mapping(NULL), view(NULL), fileSize(0), frames(0), header(NULL), index(NULL)
+{
+}
+
+SequenceReader::~SequenceReader()
+{
+    close();
+}
+
+bool SequenceReader::open(const std::string& fileName)
+{
+    close();
+
+    file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, NULL);
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        std::cout << "SequenceReader: can't open " << fileName << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if( !GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)SEQUENCE_HEADER_SIZE )
+    {
+        std::cout << "SequenceReader: " << fileName << " is too small for a sequence file" << std::endl;
+        close();
+        return false;
+    }
+    fileSize = (unsigned long long)size.QuadPart;
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if( mapping != NULL )
+        view = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if( view == NULL )
+    {
+        std::cout << "SequenceReader: can't map " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    // every size is compared by division, a corrupt header must not overflow into a valid one
+    const SequenceHeader* h = (const SequenceHeader*)view;
+    unsigned int bytes_per_pixel = h->bitDepth / 8;
+    bool valid = std::memcmp(h->magic, SEQUENCE_MAGIC, sizeof(h->magic)) == 0
+        && h->version == SEQUENCE_VERSION
+        && h->indexEntrySize == sizeof(SequenceIndexEntry)
+        && (h->bitDepth == 8 || h->bitDepth == 16)
+        && h->width > 0 && h->height > 0
+        && (unsigned long long)h->width * h->height <= ULLONG_MAX / bytes_per_pixel
+        && h->frameBytes == (unsigned long long)h->width * h->height * bytes_per_pixel
+        && h->dataOffset >= h->headerSize && h->dataOffset <= fileSize;
+    if( valid && h->frameCount > 0 )
+    {
+        // closed file: the index follows the last frame
+        valid = h->indexOffset >= h->dataOffset && h->indexOffset <= fileSize
+            && (h->indexOffset - h->dataOffset) % h->frameBytes == 0
+            && (h->indexOffset - h->dataOffset) / h->frameBytes == h->frameCount
+            && h->frameCount <= (fileSize - h->indexOffset) / sizeof(SequenceIndexEntry);
+    }
+    if( !valid )
+    {
+        std::cout << "SequenceReader: " << fileName << " is not a valid sequence file" << std::endl;
+        close();
+        return false;
+    }
+
+    header = h;
+    if( h->frameCount > 0 )
+    {
+        frames = h->frameCount;
+        index = (const SequenceIndexEntry*)(view + h->indexOffset);
+        return true;
+    }
+
+    // not closed: the frames lie between dataOffset and the reserved index, there is no index
+    unsigned long long data_end = h->indexOffset >= h->dataOffset && h->indexOffset < fileSize ? h->indexOffset : fileSize;
+    frames = (data_end - h->dataOffset) / h->frameBytes;
+    index = NULL;
+    std::cout << "SequenceReader: " << fileName << " was not closed, recovered " << frames
+              << " frames without Id, temperature and timestamp (frames never written are blank)" << std::endl;
+    return true;
+}
+
+void SequenceReader::close()
+{
+    if( view != NULL )
+        UnmapViewOfFile(view);
+    if( mapping != NULL )
+        CloseHandle(mapping);
+    if( file != INVALID_HANDLE_VALUE )
+        CloseHandle(file);
+    view = NULL;
+    mapping = NULL;
+    file = INVALID_HANDLE_VALUE;
+    fileSize = 0;
+    frames = 0;
+    header = NULL;
+    index = NULL;
+}
+
+const unsigned char* SequenceReader::pixels(unsigned long long first, unsigned long long count, size_t numel, unsigned int bit_depth) const
+{
+    if( header == NULL || header->bitDepth != bit_depth )
+    {
+        std::cout << "SequenceReader: no " << bit_depth << "-bit sequence open" << std::endl;
+        return NULL;
+    }
+    if( count == 0 || first >= frames || count > frames - first
+        || numel != count * header->width * header->height )
+    {
+        std::cout << "SequenceReader: frames " << first << " + " << count << " with " << numel << " pixels are out of range" << std::endl;
+        return NULL;
+    }
+    return view + header->dataOffset + first * header->frameBytes;
+}
+
+const unsigned short* SequenceReader::frame16(unsigned long long frame, size_t numel) const
+{
+    return (const unsigned short*)pixels(frame, 1, numel, 16);
+}
+
+const unsigned char* SequenceReader::frame8(unsigned long long frame, size_t numel) const
+{
+    return pixels(frame, 1, numel, 8);
+}
+
+const unsigned short* SequenceReader::frames16(unsigned long long first, unsigned long long count, size_t numel) const
+{
+    return (const unsigned short*)pixels(first, count, numel, 16);
+}
+
+const unsigned char* SequenceReader::frames8(unsigned long long first, unsigned long long count, size_t numel) const
+{
+    return pixels(first, count, numel, 8);
+}
+
+bool SequenceReader::readFrames16(unsigned long long first, unsigned long long count, unsigned long long stride,
+                                  unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns,
+                                  unsigned short* data, size_t numel) const
+{
+    if( header == NULL || header->bitDepth != 16 )
+    {
+        std::cout << "SequenceReader: no 16-bit sequence open" << std::endl;
+        return false;
+    }
+    return gather(first, count, stride, roiRow, roiColumn, roiRows, roiColumns, data, numel);
+}
+
+bool SequenceReader::readFrames8(unsigned long long first, unsigned long long count, unsigned long long stride,
+                                 unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns,
+                                 unsigned char* data, size_t numel) const
+{
+    if( header == NULL || header->bitDepth != 8 )
+    {
+        std::cout << "SequenceReader: no 8-bit sequence open" << std::endl;
+        return false;
+    }
+    return gather(first, count, stride, roiRow, roiColumn, roiRows, roiColumns, data, numel);
+}
+
+template< typename T >
+bool SequenceReader::gather(unsigned long long first, unsigned long long count, unsigned long long stride,
+                            unsigned int roiRow, unsigned int roiColumn, unsigned int roiRows, unsigned int roiColumns,
+                            T* data, size_t numel) const
+{
+    if( stride == 0 )
+        stride = 1;
+    bool valid = data != NULL && count > 0 && first < frames
+        && (count - 1) <= (frames - 1 - first) / stride
+        && roiRows > 0 && roiColumns > 0
+        && roiRow < header->height && roiRows <= header->height - roiRow
+        && roiColumn < header->width && roiColumns <= header->width - roiColumn
+        && numel == count * roiRows * roiColumns;
+    if( !valid )
+    {
+        std::cout << "SequenceReader: selection of " << count << " frames from " << first << " step " << stride
+                  << ", ROI " << roiRows << " x " << roiColumns << " at (" << roiRow << ", " << roiColumn << ")"
+                  << " doesn't fit the sequence or " << numel << " pixels" << std::endl;
+        return false;
+    }
+
+    const T* src = (const T*)(view + header->dataOffset);
+    size_t frame_size = (size_t)header->width * header->height;
+    size_t row_bytes = roiColumns * sizeof(T);
+    for( unsigned long long k = 0; k < count; ++k )
+    {
+        const T* frame = src + (first + k * stride) * frame_size + (size_t)roiRow * header->width + roiColumn;
+        if( roiColumns == header->width )
+        {
+            // full rows are contiguous
+            std::memcpy(data, frame, roiRows * row_bytes);
+            data += (size_t)roiRows * roiColumns;
+            continue;
+        }
+        for( unsigned int r = 0; r < roiRows; ++r )
+        {
+            std::memcpy(data, frame + (size_t)r * header->width, row_bytes);
+            data += roiColumns;
+        }
+    }
+    return true;
+}
+
+unsigned long long SequenceReader::frameId(unsigned long long frame) const
+{
+    return index != NULL && frame < frames ? index[frame].id : 0;
+}
+
+float SequenceReader::frameTemperature(unsigned long long frame) const
+{
+    return index != NULL && frame < frames ? index[frame].temperature : 0.0f;
+}
+
+double SequenceReader::frameTimestamp(unsigned long long frame) const
+{
+    return index != NULL && frame < frames ? index[frame].timestamp : 0.0;
+}
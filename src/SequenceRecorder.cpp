@@ -0,0 +1,307 @@
+#include "SequenceRecorder.h"
+#include "PixelConvert.h"
+
+#include <cstring>
+#include <iostream>
+#include <new>
+
+// a chunk is written with one WriteFile, large enough to keep the disk streaming
+static const size_t CHUNK_TARGET_BYTES = 4 << 20;
+static const unsigned int CHUNK_COUNT = 8;
+
+SequenceRecorder::SequenceRecorder() : file(INVALID_HANDLE_VALUE), chunkBytes(0), framesPerChunk(0),
+                                       armed(false), capacity(0), recorded(0), dropped(0), current(-1),
+                                       framesWritten(0), writeFailed(false), stopWriter(false)
+{
+    std::memset(&header, 0, sizeof(header));
+}
+
+SequenceRecorder::~SequenceRecorder()
+{
+    if( isOpen() )
+        close();
+}
+
+bool SequenceRecorder::open(const std::string& file_name, unsigned int frame_count, unsigned int rows, unsigned int columns, bool eight_bit)
+{
+    if( isOpen() )
+        close();
+    if( frame_count == 0 || rows == 0 || columns == 0 )
+    {
+        std::cout << "SequenceRecorder: invalid size " << frame_count << " x " << rows << " x " << columns << std::endl;
+        return false;
+    }
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SEQUENCE_MAGIC, sizeof(header.magic));
+    header.version = SEQUENCE_VERSION;
+    header.headerSize = SEQUENCE_HEADER_SIZE;
+    header.width = columns;
+    header.height = rows;
+    header.bitDepth = eight_bit ? 8 : 16;
+    header.indexEntrySize = sizeof(SequenceIndexEntry);
+    header.frameCount = 0;
+    header.frameBytes = (uint64_t)rows * columns * (eight_bit ? 1 : 2);
+    header.dataOffset = SEQUENCE_HEADER_SIZE;
+    header.indexOffset = header.dataOffset + (uint64_t)frame_count * header.frameBytes;
+
+    file = CreateFileA(file_name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                       CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        std::cout << "SequenceRecorder: can't create " << file_name << std::endl;
+        return false;
+    }
+    path = file_name;
+
+    // reserve the whole file up front so the file system doesn't grow it frame by frame
+    LARGE_INTEGER size;
+    size.QuadPart = (LONGLONG)(header.indexOffset + (uint64_t)frame_count * sizeof(SequenceIndexEntry));
+    std::vector< char > block(SEQUENCE_HEADER_SIZE, 0);
+    std::memcpy(block.data(), &header, sizeof(header));
+    if( !SetFilePointerEx(file, size, NULL, FILE_BEGIN) || !SetEndOfFile(file)
+        || !writeAt(0, block.data(), block.size()) )
+    {
+        std::cout << "SequenceRecorder: can't reserve " << size.QuadPart << " bytes for " << file_name << std::endl;
+        releaseFile();
+        return false;
+    }
+    // the file pointer is now at dataOffset, the writer thread appends from there
+
+    framesPerChunk = (unsigned int)(CHUNK_TARGET_BYTES / header.frameBytes);
+    framesPerChunk = framesPerChunk == 0 ? 1 : framesPerChunk > frame_count ? frame_count : framesPerChunk;
+    chunkBytes = (size_t)framesPerChunk * header.frameBytes;
+
+    // the file is written through the system cache, the chunks need no particular alignment
+    freeChunks.clear();
+    fullChunks.clear();
+    try
+    {
+        chunks.resize(CHUNK_COUNT);
+        for( unsigned int i = 0; i < CHUNK_COUNT; ++i )
+        {
+            chunks[i].data.resize(chunkBytes);
+            chunks[i].frames = 0;
+            freeChunks.push_back(i);
+        }
+    }
+    catch( std::bad_alloc& )
+    {
+        std::cout << "SequenceRecorder: out of memory" << std::endl;
+        releaseFile();
+        return false;
+    }
+
+    index.clear();
+    index.reserve(frame_count);
+    framesWritten = 0;
+    writeFailed = false;
+    stopWriter = false;
+    writer = std::thread(&SequenceRecorder::writeLoop, this);
+
+    std::lock_guard<std::mutex> lock(recordMutex);
+    capacity = frame_count;
+    recorded = 0;
+    dropped = 0;
+    current = freeChunks.front();
+    freeChunks.pop_front();
+    armed = true;
+    return true;
+}
+
+bool SequenceRecorder::close()
+{
+    if( !isOpen() )
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        armed = false;
+        if( current >= 0 )
+        {
+            std::lock_guard<std::mutex> queue_lock(queueMutex);
+            if( chunks[current].frames > 0 )
+                fullChunks.push_back(current);
+            else
+                freeChunks.push_back(current);
+            current = -1;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopWriter = true;
+    }
+    queueCondition.notify_all();
+    writer.join();
+
+    // chunks are written in order, so the first framesWritten index entries belong to the frames on disk
+    bool ok = !writeFailed;
+    header.frameCount = framesWritten;
+    header.indexOffset = header.dataOffset + framesWritten * header.frameBytes;
+    size_t index_bytes = (size_t)framesWritten * sizeof(SequenceIndexEntry);
+
+    std::vector< char > block(SEQUENCE_HEADER_SIZE, 0);
+    std::memcpy(block.data(), &header, sizeof(header));
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)(header.indexOffset + index_bytes);
+    // unused reserved space is cut off
+    ok = writeAt(header.indexOffset, index.data(), index_bytes)
+        && SetFilePointerEx(file, end, NULL, FILE_BEGIN) && SetEndOfFile(file)
+        && writeAt(0, block.data(), block.size()) && ok;
+    if( !ok )
+        std::cout << "SequenceRecorder: writing " << path << " failed" << std::endl;
+
+    releaseFile();
+    return ok;
+}
+
+unsigned int SequenceRecorder::frames()
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    return recorded;
+}
+
+unsigned int SequenceRecorder::droppedFrames()
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    return dropped;
+}
+
+void SequenceRecorder::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    for( ;; )
+    {
+        queueCondition.wait(lock, [this] { return stopWriter || !fullChunks.empty(); });
+        if( fullChunks.empty() )
+            return;
+
+        int c = fullChunks.front();
+        fullChunks.pop_front();
+        bool skip = writeFailed;
+        lock.unlock();
+
+        // after a failed write the file position is unknown, the remaining chunks are discarded
+        bool ok = false;
+        if( !skip )
+        {
+            const unsigned char* data = chunks[c].data.data();
+            size_t bytes = (size_t)chunks[c].frames * header.frameBytes;
+            ok = true;
+            while( ok && bytes > 0 )
+            {
+                DWORD part = bytes > (1u << 30) ? (1u << 30) : (DWORD)bytes;
+                DWORD written = 0;
+                ok = WriteFile(file, data, part, &written, NULL) && written == part;
+                data += part;
+                bytes -= part;
+            }
+        }
+
+        lock.lock();
+        if( ok )
+            framesWritten += chunks[c].frames;
+        else
+            writeFailed = true;
+        chunks[c].frames = 0;
+        freeChunks.push_back(c);
+    }
+}
+
+bool SequenceRecorder::writeAt(unsigned long long offset, const void* data, size_t bytes)
+{
+    LARGE_INTEGER position;
+    position.QuadPart = (LONGLONG)offset;
+    if( !SetFilePointerEx(file, position, NULL, FILE_BEGIN) )
+        return false;
+    const char* src = (const char*)data;
+    while( bytes > 0 )
+    {
+        DWORD part = bytes > (1u << 30) ? (1u << 30) : (DWORD)bytes;
+        DWORD written = 0;
+        if( !WriteFile(file, src, part, &written, NULL) || written != part )
+            return false;
+        src += part;
+        bytes -= part;
+    }
+    return true;
+}
+
+void SequenceRecorder::releaseFile()
+{
+    if( file != INVALID_HANDLE_VALUE )
+        CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
+    chunks.clear();
+    freeChunks.clear();
+    fullChunks.clear();
+}
+
+bool SequenceRecorder::waitForFrames(unsigned int count, const std::chrono::steady_clock::time_point& deadline)
+{
+    std::unique_lock<std::mutex> lock(recordMutex);
+    return frameCondition.wait_until(lock, deadline, [this, count] { return recorded + dropped >= count; });
+}
+
+void SequenceRecorder::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        record(frame);
+    }
+    frameCondition.notify_all();
+}
+
+void SequenceRecorder::record(const NITLibrary::NITFrame& frame)
+{
+    if( !armed || recorded >= capacity )
+        return;
+
+    if( frame.rows() != header.height || frame.columns() != header.width || frame.pixelType() != NITLibrary::NITFrame::FLOAT )
+    {
+        ++dropped;
+        return;
+    }
+
+    if( current < 0 )
+    {
+        std::lock_guard<std::mutex> queue_lock(queueMutex);
+        if( freeChunks.empty() )
+        {
+            // the disk is behind, don't stall the pipeline
+            ++dropped;
+            return;
+        }
+        current = freeChunks.front();
+        freeChunks.pop_front();
+    }
+
+    Chunk& chunk = chunks[current];
+    size_t frame_size = (size_t)header.height * header.width;
+    unsigned char* dst = chunk.data.data() + (size_t)chunk.frames * header.frameBytes;
+    if( header.bitDepth == 8 )
+        packUint8(frame.data(), dst, frame_size);
+    else
+        packUint16(frame.data(), (unsigned short*)dst, frame_size);
+
+    SequenceIndexEntry entry;
+    entry.id = frame.Id();
+    entry.temperature = frame.temperature();
+    entry.reserved = 0;
+    entry.timestamp = frame.gigeTimestamp();
+    index.push_back(entry);
+    ++recorded;
+
+    if( ++chunk.frames == framesPerChunk )
+    {
+        std::lock_guard<std::mutex> queue_lock(queueMutex);
+        fullChunks.push_back(current);
+        current = -1;
+        if( !freeChunks.empty() )
+        {
+            current = freeChunks.front();
+            freeChunks.pop_front();
+        }
+        queueCondition.notify_one();
+    }
+}
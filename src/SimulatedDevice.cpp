@@ -0,0 +1,585 @@
+#include "CameraSelector.h"
+// listed with the camera sources, built only when CameraSelector.h selects the simulated camera
+#if CAMERA_MODEL == SIMULATED_DEVICE
+
+#include "SimulatedDevice.h"
+#include "ParamCache.h"
+#include "UsbConfigObserver.h"
+
+#include <NITException.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace NITLibrary;
+
+namespace
+{
+    const char* const MODES[] = { "Global Shutter", "Gated" };
+    const char* const RESPONSES[] = { "Lin", "Log" };
+    const char* const INTEGRATION_MODES[] = { "Itr", "Iwr" };
+    const char* const GAINS[] = { "Low", "High" };
+    const char* const TRIGGER_MODES[] = { "Disabled", "Input", "Output" };
+
+    const double METRES_PER_MICROSECOND = 299.792458 / 2.0;
+    const double LASER_PULSE_US = 0.05;
+    const double READOUT_US = 200.0;
+    const float MAX_PIXEL_VALUE = 16383.0f;
+    const size_t NOISE_SIZE = 1 << 16;
+
+    unsigned int nextRandom(unsigned int& seed)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed;
+    }
+}
+
+SimulatedDevice::SimulatedDevice(unsigned int sensor_width, unsigned int sensor_height, double max_fps, const std::string& serial_number)
+    : width(sensor_width), height(sensor_height), serial(serial_number), sensorMaxFps(max_fps), nucOn(false), bprOn(false), configObserver(NULL),
+      currentFps(max_fps / 2), fpsMin(1.0), fpsMax(max_fps), frameRows(sensor_height), frameColumns(sensor_width),
+      streaming(false), delivering(false), quit(false), remaining(0), countErrors(false), timed(false), dropCount(0),
+      frameId(0), noiseSeed(12345)
+{
+    addEnum("Mode", MODES, 2, 0);
+    addEnum("Sensor Response", RESPONSES, 2, 0);
+    addEnum("IntegrationMode", INTEGRATION_MODES, 2, 0);
+    addEnum("AnalogGain", GAINS, 2, 0);
+    addEnum("Trigger Mode", TRIGGER_MODES, 3, 0);
+    addNumber("Exposure Time", 1.0, 100000.0, 1.0, 1000.0);
+    addNumber("Trigger Delay Input", 0.0, 100.0, 0.01, 0.0);
+    addNumber("First Column", 0.0, width - 1.0, 1.0, 0.0);
+    addNumber("NumberOfColumns", 1.0, width, 1.0, width);
+    addNumber("First Line", 0.0, height - 1.0, 1.0, 0.0);
+    addNumber("Number of Lines", 1.0, height, 1.0, height);
+
+    noise.resize(NOISE_SIZE);
+    unsigned int seed = 42;
+    for( size_t i = 0; i < noise.size(); ++i )
+        noise[i] = (float)(nextRandom(seed) >> 8) / (float)(1 << 24) * 16.0f - 8.0f;
+
+    updateRanges();
+    renderScene();
+    epoch = std::chrono::steady_clock::now();
+    streamThread = std::thread(&SimulatedDevice::streamLoop, this);
+}
+
+SimulatedDevice::~SimulatedDevice()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        quit = true;
+        streaming = false;
+    }
+    stateCondition.notify_all();
+    streamThread.join();
+}
+
+void SimulatedDevice::addEnum(const std::string& name, const char* const* choices, unsigned int count, unsigned int current)
+{
+    Param& param = params[ParamCache::key(name)];
+    param.name = name;
+    param.choices.assign(choices, choices + count);
+    param.minValue = 0.0;
+    param.maxValue = count - 1.0;
+    param.step = 1.0;
+    param.value = current;
+}
+
+void SimulatedDevice::addNumber(const std::string& name, double min_value, double max_value, double step, double current)
+{
+    Param& param = params[ParamCache::key(name)];
+    param.name = name;
+    param.minValue = min_value;
+    param.maxValue = max_value;
+    param.step = step;
+    param.value = current;
+}
+
+SimulatedDevice::Param& SimulatedDevice::find(const char* name)
+{
+    std::map< std::string, Param >::iterator it = params.find(ParamCache::key(name));
+    if( it == params.end() )
+        NITException::DefaultThrowFunc((std::string("Unknown parameter: ") + name).c_str());
+    return it->second;
+}
+
+const SimulatedDevice::Param& SimulatedDevice::find(const char* name) const
+{
+    std::map< std::string, Param >::const_iterator it = params.find(ParamCache::key(name));
+    if( it == params.end() )
+        NITException::DefaultThrowFunc((std::string("Unknown parameter: ") + name).c_str());
+    return it->second;
+}
+
+double SimulatedDevice::number(const char* name) const
+{
+    return find(name).value;
+}
+
+const std::string& SimulatedDevice::choice(const char* name) const
+{
+    const Param& param = find(name);
+    return param.choices[(size_t)param.value];
+}
+
+std::string SimulatedDevice::format(const Param& param)
+{
+    if( !param.choices.empty() )
+        return param.choices[(size_t)param.value];
+    std::ostringstream out;
+    out << param.value;
+    return out.str();
+}
+
+bool SimulatedDevice::apply(Param& param, double value)
+{
+    // out of range values are clamped and values between two steps rounded, like the camera does
+    double v = value < param.minValue ? param.minValue : value > param.maxValue ? param.maxValue : value;
+    v = param.minValue + std::floor((v - param.minValue) / param.step + 0.5) * param.step;
+    v = v > param.maxValue ? param.maxValue : v;
+    if( v == param.value )
+        return false;
+    param.value = v;
+    return true;
+}
+
+void SimulatedDevice::stage(const char* name, const std::string* str_value, double num_value)
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    const Param& param = find(name);
+    double v = num_value;
+    if( str_value != NULL && !param.choices.empty() )
+    {
+        // unknown values are rejected right away, like the SDK does
+        std::string k = ParamCache::key(*str_value);
+        size_t i = 0;
+        while( i < param.choices.size() && ParamCache::key(param.choices[i]) != k )
+            ++i;
+        if( i == param.choices.size() )
+            NITException::DefaultThrowFunc(("Invalid value " + *str_value + " for " + param.name).c_str());
+        v = (double)i;
+    }
+    else if( str_value != NULL )
+        v = std::atof(str_value->c_str());
+    staged.push_back(std::make_pair(param.name, v));
+}
+
+bool SimulatedDevice::updateRanges()
+{
+    // gated exposures are a few hundred ns, the global shutter ones up to 100 ms
+    Param& exposure = find("Exposure Time");
+    bool gated = number("Mode") == 1.0;
+    double min_expo = gated ? 0.1 : 1.0;
+    double max_expo = gated ? 2.5 : 100000.0;
+    double step = gated ? 0.1 : 1.0;
+    bool range_changed = exposure.minValue != min_expo || exposure.maxValue != max_expo;
+    exposure.minValue = min_expo;
+    exposure.maxValue = max_expo;
+    exposure.step = step;
+    exposure.value = exposure.value < min_expo ? min_expo : exposure.value > max_expo ? max_expo : exposure.value;
+
+    // the region of interest can't leave the sensor
+    Param& columns = find("NumberOfColumns");
+    columns.maxValue = width - number("First Column");
+    columns.value = columns.value > columns.maxValue ? columns.maxValue : columns.value;
+    Param& lines = find("Number of Lines");
+    lines.maxValue = height - number("First Line");
+    lines.value = lines.value > lines.maxValue ? lines.maxValue : lines.value;
+    frameColumns = (unsigned int)columns.value;
+    frameRows = (unsigned int)lines.value;
+
+    // smaller frames read out faster, long exposures limit the frame rate
+    double readout = READOUT_US * frameRows / height;
+    double max_fps = 1e6 / (exposure.value + readout);
+    fpsMax = max_fps < sensorMaxFps ? max_fps : sensorMaxFps;
+    currentFps = currentFps > fpsMax ? fpsMax : currentFps < fpsMin ? fpsMin : currentFps;
+    return range_changed;
+}
+
+void SimulatedDevice::renderScene()
+{
+    bool gated = number("Mode") == 1.0;
+    double exposure = number("Exposure Time");
+    double delay = number("Trigger Delay Input");
+    double gain = choice("AnalogGain") == "High" ? 2.0 : 1.0;
+    unsigned int first_column = (unsigned int)number("First Column");
+    unsigned int first_line = (unsigned int)number("First Line");
+
+    scene.resize((size_t)frameRows * frameColumns);
+    double sigma = (exposure + LASER_PULSE_US) / 2.5;
+    double disc_radius = height / 5.0;
+    for( unsigned int y = 0; y < frameRows; ++y )
+    {
+        for( unsigned int x = 0; x < frameColumns; ++x )
+        {
+            double c = first_column + x, r = first_line + y;
+            // a wall going from 15 m to 60 m from left to right, a disc at 30 m in the centre
+            double dx = c - width / 2.0, dy = r - height / 2.0;
+            bool disc = dx * dx + dy * dy < disc_radius * disc_radius;
+            double depth = disc ? 30.0 : 15.0 + 45.0 * c / (width > 1 ? width - 1 : 1);
+            double reflectivity = disc ? 0.9 : 0.5;
+
+            double signal;
+            if( gated )
+            {
+                // the echo is brightest when the gate is centred on it
+                double tof = depth / METRES_PER_MICROSECOND;
+                double t = (delay + exposure / 2.0 - tof - LASER_PULSE_US / 2.0) / sigma;
+                signal = 12000.0 * reflectivity * std::exp(-0.5 * t * t);
+            }
+            else
+                signal = 1.2 * reflectivity * (exposure < 10000.0 ? exposure : 10000.0);
+
+            double v = 200.0 + gain * signal;
+            scene[(size_t)y * frameColumns + x] = (float)(v < MAX_PIXEL_VALUE ? v : MAX_PIXEL_VALUE);
+        }
+    }
+}
+
+void SimulatedDevice::notifyParam(const Param& param)
+{
+    if( configObserver != NULL )
+        configObserver->onParamChanged(param.name.c_str(), format(param).c_str(), (float)param.value);
+}
+
+void SimulatedDevice::notifyRange(const Param& param)
+{
+    if( configObserver == NULL )
+        return;
+    // numeric ranges are reported by their limits only
+    std::vector< std::string > values;
+    std::vector< float > numbers;
+    if( !param.choices.empty() )
+    {
+        values = param.choices;
+        for( size_t i = 0; i < values.size(); ++i )
+            numbers.push_back((float)i);
+    }
+    else
+    {
+        Param limit = param;
+        limit.value = param.minValue;
+        values.push_back(format(limit));
+        limit.value = param.maxValue;
+        values.push_back(format(limit));
+        numbers.push_back((float)param.minValue);
+        numbers.push_back((float)param.maxValue);
+    }
+    std::vector< const char* > pointers;
+    for( size_t i = 0; i < values.size(); ++i )
+        pointers.push_back(values[i].c_str());
+    configObserver->onParamRangeChanged(param.name.c_str(), pointers.data(), numbers.data(),
+                                            (unsigned int)pointers.size(), format(param).c_str(), (float)param.value);
+}
+
+void SimulatedDevice::notifyFps(double min_fps, double max_fps, double fps)
+{
+    if( configObserver != NULL )
+        configObserver->onFpsRangeChanged(min_fps, max_fps, fps);
+}
+
+void SimulatedDevice::setFps(double new_fps)
+{
+    double fps_now;
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        currentFps = new_fps < fpsMin ? fpsMin : new_fps > fpsMax ? fpsMax : new_fps;
+        fps_now = currentFps;
+    }
+    if( configObserver != NULL )
+        configObserver->onFpsChanged(fps_now);
+}
+
+double SimulatedDevice::fps() const
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return currentFps;
+}
+
+double SimulatedDevice::minFps() const
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return fpsMin;
+}
+
+double SimulatedDevice::maxFps() const
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return fpsMax;
+}
+
+void SimulatedDevice::setRoi(unsigned int offset_x, unsigned int offset_y, unsigned int roi_width, unsigned int roi_height)
+{
+    setParamValueOf("First Column", offset_x);
+    setParamValueOf("First Line", offset_y);
+    setParamValueOf("NumberOfColumns", roi_width);
+    setParamValueOf("Number of Lines", roi_height);
+    updateConfig();
+}
+
+void SimulatedDevice::updateConfig()
+{
+    std::vector< Param > changed, ranges;
+    double old_min, old_max, min_fps, max_fps, fps_now;
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        old_min = fpsMin;
+        old_max = fpsMax;
+        for( size_t i = 0; i < staged.size(); ++i )
+        {
+            Param& param = find(staged[i].first.c_str());
+            if( apply(param, staged[i].second) )
+                changed.push_back(param);
+        }
+        staged.clear();
+        if( updateRanges() )
+            ranges.push_back(find("Exposure Time"));
+        renderScene();
+        min_fps = fpsMin;
+        max_fps = fpsMax;
+        fps_now = currentFps;
+    }
+
+    // observers are called without the lock so they can query the device
+    for( size_t i = 0; i < ranges.size(); ++i )
+        notifyRange(ranges[i]);
+    for( size_t i = 0; i < changed.size(); ++i )
+        notifyParam(changed[i]);
+    if( min_fps != old_min || max_fps != old_max )
+        notifyFps(min_fps, max_fps, fps_now);
+}
+
+void SimulatedDevice::start()
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    streaming = true;
+    remaining = -1;
+    timed = false;
+    countErrors = false;
+    stateCondition.notify_all();
+}
+
+void SimulatedDevice::captureNFrames(size_t n, bool error_increment_count)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    streaming = n > 0;
+    remaining = (long long)n;
+    timed = false;
+    countErrors = error_increment_count;
+    stateCondition.notify_all();
+}
+
+void SimulatedDevice::captureForDuration(unsigned long milliseconds)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    streaming = true;
+    remaining = -1;
+    timed = true;
+    endTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    countErrors = false;
+    stateCondition.notify_all();
+}
+
+void SimulatedDevice::stop()
+{
+    // must not be called from the pipeline
+    std::unique_lock<std::mutex> lock(stateMutex);
+    streaming = false;
+    stateCondition.notify_all();
+    stateCondition.wait(lock, [this] { return !delivering; });
+}
+
+bool SimulatedDevice::waitEndCapture(int timeout)
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    if( timeout < 0 )
+    {
+        stateCondition.wait(lock, [this] { return !streaming && !delivering; });
+        return true;
+    }
+    if( stateCondition.wait_for(lock, std::chrono::milliseconds(timeout), [this] { return !streaming && !delivering; }) )
+        return true;
+    // like the SDK the streaming ends with the timeout
+    streaming = false;
+    stateCondition.notify_all();
+    stateCondition.wait(lock, [this] { return !delivering; });
+    return false;
+}
+
+unsigned long long SimulatedDevice::droppedFrames()
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return dropCount;
+}
+
+NITFilter& SimulatedDevice::operator<<(NITFilter& filter)
+{
+    downstream.push_back(&filter);
+    return filter;
+}
+
+void SimulatedDevice::operator<<(NITObserver& observer)
+{
+    downstream.push_back(&observer);
+}
+
+void SimulatedDevice::operator<<(NITConfigObserver& observer)
+{
+    // the callbacks are protected, only an observer that befriends the simulator can be called
+    UsbConfigObserver* usb_observer = dynamic_cast< UsbConfigObserver* >(&observer);
+    if( usb_observer == NULL )
+    {
+        std::cout << "SimulatedDevice: only a UsbConfigObserver can be connected" << std::endl;
+        return;
+    }
+    configObserver = usb_observer;
+    // a new observer gets the range and value of every parameter
+    std::vector< Param > all;
+    double min_fps, max_fps, fps_now;
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        for( std::map< std::string, Param >::const_iterator it = params.begin(); it != params.end(); ++it )
+            all.push_back(it->second);
+        min_fps = fpsMin;
+        max_fps = fpsMax;
+        fps_now = currentFps;
+    }
+    for( size_t i = 0; i < all.size(); ++i )
+        notifyRange(all[i]);
+    notifyFps(min_fps, max_fps, fps_now);
+}
+
+void SimulatedDevice::streamLoop()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    for( ;; )
+    {
+        stateCondition.wait(lock, [this] { return quit || streaming; });
+        if( quit )
+            return;
+
+        std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+        bool triggered;
+        {
+            std::lock_guard<std::mutex> config_lock(configMutex);
+            triggered = choice("Trigger Mode") == "Input";
+        }
+        if( triggered )
+        {
+            // simulated cameras share the trigger: its pulses sit on a grid of the steady clock
+            double period = 1.0 / fps();
+            double pulses = std::ceil(std::chrono::duration<double>(next.time_since_epoch()).count() / period);
+            next = std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(pulses * period)));
+        }
+        while( streaming && !quit )
+        {
+            if( stateCondition.wait_until(lock, next, [this] { return !streaming || quit; }) )
+                break;
+
+            std::chrono::duration<double> period(1.0 / fps());
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            // a frame more than one period late was overwritten in the camera buffer
+            bool late = now - next > period;
+            delivering = true;
+            lock.unlock();
+
+            if( late )
+            {
+                ++frameId;
+                if( configObserver != NULL )
+                    configObserver->onNewFrame(1);
+            }
+            else
+                deliverFrame();
+
+            lock.lock();
+            delivering = false;
+            next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+            if( late )
+                ++dropCount;
+            if( remaining > 0 && (!late || countErrors) && --remaining == 0 )
+                streaming = false;
+            if( timed && now >= endTime )
+                streaming = false;
+            stateCondition.notify_all();
+        }
+    }
+}
+
+void SimulatedDevice::deliverFrame()
+{
+    unsigned int rows, columns;
+    {
+        // the frame is rendered under the lock so updateConfig can't change the scene in between
+        std::lock_guard<std::mutex> lock(configMutex);
+        rows = frameRows;
+        columns = frameColumns;
+        size_t frame_size = scene.size();
+        frame.resize(frame_size);
+        size_t offset = nextRandom(noiseSeed) >> 16;
+        const float* src = scene.data();
+        const float* n = noise.data();
+        float* dst = frame.data();
+        for( size_t i = 0; i < frame_size; ++i )
+        {
+            float v = src[i] + n[(i + offset) & (NOISE_SIZE - 1)];
+            dst[i] = v < 0.0f ? 0.0f : v > MAX_PIXEL_VALUE ? MAX_PIXEL_VALUE : v;
+        }
+    }
+
+    double ticks = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    NITFrame nit_frame(14, frame.data(), columns, rows, frameId++, 30.0f, ticks);
+    if( configObserver != NULL )
+        configObserver->onNewFrame(0);
+    for( size_t i = 0; i < downstream.size(); ++i )
+        downstream[i]->onNewImage(nit_frame);
+}
+
+void SimulatedDevice::setNucDirectory(const std::string& dir_path, bool /*is_bpr_path*/)
+{
+    std::cout << "SimulatedDevice: NUC " << dir_path << " ignored" << std::endl;
+}
+
+void SimulatedDevice::setNucFile(const std::string& file_path)
+{
+    std::cout << "SimulatedDevice: NUC " << file_path << " ignored" << std::endl;
+}
+
+void SimulatedDevice::setBprFile(const std::string& file_path)
+{
+    std::cout << "SimulatedDevice: BPR " << file_path << " ignored" << std::endl;
+}
+
+double SimulatedDevice::paramValueOf(const std::string& param_name) const
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return number(param_name.c_str());
+}
+
+std::string SimulatedDevice::paramStrValueOf(const std::string& param_name) const
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return format(find(param_name.c_str()));
+}
+
+CameraDevice& SimulatedDevice::setParamValueOf(const std::string& param_name, unsigned int value)
+{
+    return setParamValueOf(param_name, (double)value);
+}
+
+CameraDevice& SimulatedDevice::setParamValueOf(const std::string& param_name, double value)
+{
+    stage(param_name.c_str(), NULL, value);
+    return *this;
+}
+
+CameraDevice& SimulatedDevice::setParamValueOf(const std::string& param_name, const std::string& value)
+{
+    stage(param_name.c_str(), &value, 0.0);
+    return *this;
+}
+
+#endif // CAMERA_MODEL
@@ -0,0 +1,45 @@
+#include "SnapshotWriter.h"
+
+SnapshotWriter::SnapshotWriter() : remaining(0)
+{
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+}
+
+void SnapshotWriter::arm(unsigned int frame_count)
+{
+    std::lock_guard<std::mutex> lock(snapMutex);
+    remaining = frame_count;
+    // the SDK adds to its own count, what is left of it never gets a frame past remaining
+    snap(frame_count);
+}
+
+void SnapshotWriter::disarm()
+{
+    std::lock_guard<std::mutex> lock(snapMutex);
+    remaining = 0;
+}
+
+bool SnapshotWriter::waitForCounter(unsigned int counter, const std::chrono::steady_clock::time_point& deadline)
+{
+    std::unique_lock<std::mutex> lock(snapMutex);
+    return frameCondition.wait_until(lock, deadline, [this, counter] { return getCounterValue() >= counter; });
+}
+
+void SnapshotWriter::onNewFrame(const NITLibrary::NITFrame& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(snapMutex);
+        if( remaining == 0 )
+            return;
+        --remaining;
+    }
+    NITLibrary::NITToolBox::NITSnapshot::onNewFrame(frame);
+    {
+        // the counter is read under the lock in waitForCounter, don't let the notification slip in between
+        std::lock_guard<std::mutex> lock(snapMutex);
+    }
+    frameCondition.notify_all();
+}
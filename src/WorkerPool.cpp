@@ -0,0 +1,86 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(unsigned int thread_count) : job(NULL), jobCount(0), generation(0), running(0), quit(false)
+{
+    if( thread_count == 0 )
+        thread_count = std::thread::hardware_concurrency();
+    if( thread_count == 0 )
+        thread_count = 1;
+
+    // the calling thread takes the first band
+    for( unsigned int i = 1; i < thread_count; ++i )
+        workers.push_back(std::thread(&WorkerPool::run, this, i));
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        quit = true;
+    }
+    wakeUp.notify_all();
+    for( size_t i = 0; i < workers.size(); ++i )
+        workers[i].join();
+}
+
+void WorkerPool::bandRange(unsigned int index, size_t& begin, size_t& end) const
+{
+    size_t bands = size();
+    begin = jobCount * index / bands;
+    end = jobCount * (index + 1) / bands;
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& band)
+{
+    std::lock_guard<std::mutex> job_lock(jobMutex);
+
+    if( workers.empty() || count < size() )
+    {
+        band(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        job = &band;
+        jobCount = count;
+        running = (unsigned int)workers.size();
+        ++generation;
+    }
+    wakeUp.notify_all();
+
+    size_t begin, end;
+    bandRange(0, begin, end);
+    band(begin, end);
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    done.wait(lock, [this] { return running == 0; });
+    job = NULL;
+}
+
+void WorkerPool::run(unsigned int index)
+{
+    unsigned long long seen = 0;
+    for(;;)
+    {
+        const std::function<void(size_t, size_t)>* current;
+        size_t begin, end;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wakeUp.wait(lock, [this, seen] { return quit || generation != seen; });
+            if( quit )
+                return;
+            seen = generation;
+            current = job;
+            bandRange(index, begin, end);
+        }
+
+        (*current)(begin, end);
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            --running;
+        }
+        done.notify_one();
+    }
+}